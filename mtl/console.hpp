@@ -24,7 +24,7 @@
 #include "fmt_include.hpp" // fmt::print, fmt::runtime
 #include "string.hpp"      // mtl::string::to_string, mtl::string::pad, mtl::string::pad_front,
 						   // mtl::string::pad_back, mtl::string::join, mtl::string::contains
-						   // mtl::string::replace
+						   // mtl::string::replace, mtl::string::builder
 
 
 // Windows only headers
@@ -192,8 +192,10 @@ inline void print(const Arg& arg, Args&&... args)
 	// if there are any variadic arguments
 	if constexpr(number_args > 0)
 	{
-		// concatenate all arguments to a single string, so we only need a single call to print
-		fmt::print("{}", mtl::string::join(arg, std::forward<Args>(args)...));
+		// concatenate all arguments to a single buffer, so we only need a single call to print
+		mtl::string::builder buffer;
+		mtl::string::join(buffer, arg, std::forward<Args>(args)...);
+		fmt::print("{}", buffer.view());
 	}
 	// if there are no variadic arguments
 	else
@@ -416,8 +418,9 @@ inline void print_all(Iter first, Iter last, const std::string& delimiter = "",
 	}
 	
 
-	// create a buffer to store everything so we only have to print once
-	std::string buffer;
+	// create a buffer to store everything so we only have to print once, the builder appends to
+	// its storage without creating temporary strings
+	mtl::string::builder buffer;
 
 	// if printing a newline after a certain number of elements is requested
 	if (newline_threshold > 0)
@@ -433,14 +436,14 @@ inline void print_all(Iter first, Iter last, const std::string& delimiter = "",
 			// if the counter is 0 it means a new line is just starting
 			if (newline_counter == 0)
 			{
-				buffer += line_start;
+				buffer.append(line_start);
 			}
 
 			// pad the element with the given padding style
 			mtl::console::detail::print_padding_impl(element, longest, padding_style); 
 
 			// store the element in the buffer
-			buffer += element; 
+			buffer.append(element); 
 
 			++newline_counter;
 			++last_element_counter;
@@ -448,11 +451,12 @@ inline void print_all(Iter first, Iter last, const std::string& delimiter = "",
 			// check if we should add a delimiter or if it the end of a line based on the counters
 			if ((newline_counter < newline_threshold) && (last_element_counter < num_elements)) 
 			{
-				buffer += delimiter; 
+				buffer.append(delimiter); 
 			}
 			else
 			{
-				buffer = mtl::string::join(buffer, line_end, "\n");
+				buffer.append(line_end);
+				buffer.append('\n');
 				newline_counter = 0;
 			}
 		}
@@ -460,7 +464,7 @@ inline void print_all(Iter first, Iter last, const std::string& delimiter = "",
 	// if printing a newline after a certain number of elements is not requested
 	else
 	{
-		buffer += line_start; 
+		buffer.append(line_start); 
 		
 		// counter to keep track if it is the last element
 		size_t last_element_counter = 0;
@@ -471,22 +475,22 @@ inline void print_all(Iter first, Iter last, const std::string& delimiter = "",
 			mtl::console::detail::print_padding_impl(element, longest, padding_style); 
 			
 			// store the element in the buffer
-			buffer += element; 
+			buffer.append(element); 
 
 			++last_element_counter;
 			
 			// add the delimiter if it is not the last element
 			if (last_element_counter < num_elements)
 			{ 
-				buffer += delimiter; 
+				buffer.append(delimiter); 
 			}		
 		}
-		buffer += line_end; 
+		buffer.append(line_end); 
 	}
 
 	// write the entire buffer to the console, benchmarks show great performance gains 
 	// compared to printing each individual element to the console one at a time
-	fmt::print("{}", buffer);
+	fmt::print("{}", buffer.view());
 	
 	// GCOVR_EXCL_STOP
 }
@@ -12,18 +12,65 @@
 
 
 #include "definitions.hpp" // various definitions
-#include <filesystem>      // std::filesystem::file_size, std::filesystem::path, 
-						   // std::filesystem::is_regular_file
+#include <filesystem>      // std::filesystem::path, std::filesystem::is_regular_file,
+						   // std::filesystem::directory_iterator
 #include <string>          // std::string
 #include <string_view>     // std::string_view
-#include <cstdint>         // std::uintmax_t
+#include <cstdint>         // std::uintmax_t, uint16_t, uint64_t
 #include <fstream>		   // std::ofstream, std::ifstream
-#include <system_error>    // std::error_code
 #include <limits>          // std::numeric_limits
 #include <ios>			   // std::ios_base::openmode, std::ios::out, 
 						   // std::ios::binary, std::streamsize
-#include "string.hpp"      // mtl::string::join_all
-#include "utility.hpp"     // MTL_ASSERT_MSG
+#include <vector>          // std::vector
+#include <memory>          // std::unique_ptr
+#include <cstring>         // std::memchr, std::memcpy, std::memmove
+#include <utility>         // std::forward, std::move
+#include <thread>          // std::thread
+#include <atomic>          // std::atomic
+#include <algorithm>       // std::sort
+#include <system_error>    // std::error_code
+#include <mutex>           // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <type_traits>     // std::enable_if_t, std::is_convertible_v,
+						   // std::is_trivially_copyable_v
+#include <array>           // std::array
+#include <iterator>        // std::data, std::size
+#include "string.hpp"      // mtl::string::to_string, mtl::detail::for_each_char,
+						   // mtl::detail::count_char, mtl::detail::parallel_thread_count,
+						   // mtl::detail::run_parallel
+#include "utility.hpp"     // MTL_ASSERT_MSG, mtl::no_move
+
+
+// Windows only headers
+#if defined(_WIN32)
+
+// this define makes the huge Windows.h header compile faster
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+
+#if defined(__MINGW32__) || defined(__MINGW64__)
+// we need to include the lowercase windows.h header because it fixes a cross-compilation issue
+// when compiling with mingw on Linux targeting Windows
+#include <windows.h>
+#else
+// use the Windows.h header like normal
+#include <Windows.h> // HANDLE, LARGE_INTEGER, CreateFileW, GetFileSizeEx, CreateFileMappingW,
+					 // MapViewOfFile, UnmapViewOfFile, CloseHandle, ReadFile, WriteFile,
+					 // DWORD, OVERLAPPED, FlushFileBuffers
+#endif // __MINGW32__ and __MINGW64__ end
+
+
+// Linux / Unix only headers
+#else
+
+#include <sys/mman.h>  // mmap, munmap, posix_madvise
+#include <sys/stat.h>  // fstat, struct stat, S_ISREG
+#include <fcntl.h>     // open, O_RDONLY, O_WRONLY, O_CREAT, O_TRUNC, O_APPEND
+#include <unistd.h>    // close, read, write, fsync
+#include <cerrno>      // errno, EINTR
+
+#endif // _WIN32 end
 
 
 
@@ -34,213 +81,2132 @@ namespace mtl
 namespace filesystem
 {
 
+// ================================================================================================
+// MAPPED_FILE      - A read-only memory mapped file.
+// ================================================================================================
+
+/// A read-only memory mapped file. The contents of the file are accessible through a pointer or an
+/// std::string_view without copying the file to the heap. The operating system loads pages of the
+/// file on demand, so even files many times larger than the available memory can be used. The
+/// memory mapped file can't be copied but it can be moved. Changing the file from another process
+/// while it is mapped results in undefined behaviour.
+class mapped_file
+{
+	// pointer to the start of the mapped memory or nullptr if the file is empty or not open
+	const char* mapped_data = nullptr;
+	// the size of the mapped memory in bytes
+	size_t mapped_size = 0;
+	// if the file is opened, empty files are considered open even if no memory is mapped
+	bool opened = false;
+
+public:
+
+	/// Default constructor. Doesn't open any file.
+	mapped_file() = default;
+
+	/// Constructor that opens and maps a file. Use is_open to check if the file was opened
+	/// successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	explicit mapped_file(const std::filesystem::path& filename)
+	{
+		open(filename);
+	}
+
+	/// Destructor that unmaps the file.
+	~mapped_file()
+	{
+		close();
+	}
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	/// Move constructor. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::mapped_file.
+	mapped_file(mapped_file&& other) noexcept : mapped_data(other.mapped_data), 
+	mapped_size(other.mapped_size), opened(other.opened)
+	{
+		other.mapped_data = nullptr;
+		other.mapped_size = 0;
+		other.opened = false;
+	}
+
+	/// Move assignment operator. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::mapped_file.
+	/// @return A reference to this object.
+	mapped_file& operator=(mapped_file&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			mapped_data = other.mapped_data;
+			mapped_size = other.mapped_size;
+			opened = other.opened;
+			other.mapped_data = nullptr;
+			other.mapped_size = 0;
+			other.opened = false;
+		}
+		return *this;
+	}
+
+
+	// ============================================================================================
+	// OPEN             - Opens and maps a file to memory.
+	// ============================================================================================
+
+	/// Opens a file and maps it to memory as read-only. If another file is already open it is
+	/// closed first. Returns if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @return Returns if the file was opened and mapped successfully.
+	bool open(const std::filesystem::path& filename)
+	{
+		close();
+
+#if defined(_WIN32)
+
+		// open the file for reading and allow other processes to read it at the same time
+		HANDLE file_handle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+										 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) { return false; }
+
+		LARGE_INTEGER file_size {};
+		if (GetFileSizeEx(file_handle, &file_size) == 0)
+		{
+			CloseHandle(file_handle); // GCOVR_EXCL_LINE
+			return false; // GCOVR_EXCL_LINE
+		}
+
+		const auto size = static_cast<std::uintmax_t>(file_size.QuadPart);
+
+		// an empty file can't be mapped but it is still a successfully opened file
+		if (size == 0)
+		{
+			CloseHandle(file_handle);
+			opened = true;
+			return true;
+		}
+
+		// when compiling in 32 bit mode files larger than what size_t can hold can't be mapped
+		if (size > static_cast<std::uintmax_t>(std::numeric_limits<size_t>::max()))
+		{
+			CloseHandle(file_handle); // GCOVR_EXCL_LINE
+			return false; // GCOVR_EXCL_LINE
+		}
+
+		HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0,
+												   nullptr);
+		// the file handle is no longer needed, the mapping keeps the file open
+		CloseHandle(file_handle);
+		if (mapping_handle == nullptr) { return false; } // GCOVR_EXCL_LINE
+
+		void* view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		// the mapping handle is no longer needed, the view keeps the mapping alive
+		CloseHandle(mapping_handle);
+		if (view == nullptr) { return false; } // GCOVR_EXCL_LINE
+
+		mapped_data = static_cast<const char*>(view);
+		mapped_size = static_cast<size_t>(size);
+		opened = true;
+		return true;
+
+#else
+
+		// open the file for reading
+		const int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+		if (file_descriptor == -1) { return false; }
+
+		// a single fstat gives us both the file type and the file size
+		struct stat file_status {};
+		if ((fstat(file_descriptor, &file_status) != 0) || (!S_ISREG(file_status.st_mode)))
+		{
+			::close(file_descriptor);
+			return false;
+		}
+
+		const auto size = static_cast<std::uintmax_t>(file_status.st_size);
+
+		// an empty file can't be mapped but it is still a successfully opened file
+		if (size == 0)
+		{
+			::close(file_descriptor);
+			opened = true;
+			return true;
+		}
+
+		// when compiling in 32 bit mode files larger than what size_t can hold can't be mapped
+		if (size > static_cast<std::uintmax_t>(std::numeric_limits<size_t>::max()))
+		{
+			::close(file_descriptor); // GCOVR_EXCL_LINE
+			return false; // GCOVR_EXCL_LINE
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE,
+						  file_descriptor, 0);
+		// the file descriptor is no longer needed, the mapping keeps a reference to the file
+		::close(file_descriptor);
+		if (view == MAP_FAILED) { return false; } // GCOVR_EXCL_LINE
+
+		// hint to the operating system that we will read the file from start to end so it can
+		// read ahead more aggressively, it is only a hint so the result is ignored
+		posix_madvise(view, static_cast<size_t>(size), POSIX_MADV_SEQUENTIAL);
+
+		mapped_data = static_cast<const char*>(view);
+		mapped_size = static_cast<size_t>(size);
+		opened = true;
+		return true;
+
+#endif // _WIN32 end
+	}
+
+
+	// ============================================================================================
+	// CLOSE            - Unmaps and closes the file.
+	// ============================================================================================
+
+	/// Unmaps and closes the file. Any pointers or std::string_view to the file contents are
+	/// invalidated. Does nothing if no file is open.
+	void close() noexcept
+	{
+		if (mapped_data != nullptr)
+		{
+
+#if defined(_WIN32)
+			UnmapViewOfFile(mapped_data);
+#else
+			// munmap requires a non-const pointer
+			munmap(const_cast<char*>(mapped_data), mapped_size);
+#endif // _WIN32 end
+
+		}
+
+		mapped_data = nullptr;
+		mapped_size = 0;
+		opened = false;
+	}
+
+
+	// ============================================================================================
+	// IS_OPEN          - Returns if a file is open.
+	// ============================================================================================
+
+	/// Returns if a file is open.
+	/// @return If a file is open.
+	[[nodiscard]]
+	bool is_open() const noexcept
+	{
+		return opened;
+	}
+
+
+	// ============================================================================================
+	// DATA             - Returns a pointer to the start of the file contents.
+	// ============================================================================================
+
+	/// Returns a pointer to the start of the file contents. Returns nullptr if the file is empty
+	/// or not open. The contents are not null terminated.
+	/// @return A pointer to the start of the file contents.
+	[[nodiscard]]
+	const char* data() const noexcept
+	{
+		return mapped_data;
+	}
+
+
+	// ============================================================================================
+	// SIZE             - Returns the size of the file in bytes.
+	// ============================================================================================
+
+	/// Returns the size of the file contents in bytes.
+	/// @return The size of the file in bytes.
+	[[nodiscard]]
+	size_t size() const noexcept
+	{
+		return mapped_size;
+	}
+
+
+	// ============================================================================================
+	// EMPTY            - Returns if the file is empty.
+	// ============================================================================================
+
+	/// Returns if the file contents are empty. A file that is not open is also empty.
+	/// @return If the file is empty.
+	[[nodiscard]]
+	bool empty() const noexcept
+	{
+		return (mapped_size == 0);
+	}
+
+
+	// ============================================================================================
+	// VIEW             - Returns an std::string_view of the file contents.
+	// ============================================================================================
+
+	/// Returns an std::string_view of the entire file contents. The std::string_view is valid
+	/// only while the file remains open.
+	/// @return An std::string_view of the file contents.
+	[[nodiscard]]
+	std::string_view view() const noexcept
+	{
+		if (mapped_data == nullptr)
+		{
+			return std::string_view();
+		}
+		return std::string_view(mapped_data, mapped_size);
+	}
+};
+
+
+
 // ================================================================================================
 // READ_FILE        - Reads an entire file to a string.
 // ================================================================================================
 
 
+namespace detail
+{
+	// A file opened for reading using the operating system's API directly. The file is closed
+	// when the object is destroyed.
+	class native_file : mtl::no_move
+	{
+#if defined(_WIN32)
+		HANDLE file_handle = INVALID_HANDLE_VALUE;
+#else
+		int file_descriptor = -1;
+#endif // _WIN32 end
+
+	public:
+
+		native_file() = default;
+
+		~native_file()
+		{
+#if defined(_WIN32)
+			if (file_handle != INVALID_HANDLE_VALUE) { CloseHandle(file_handle); }
+#else
+			if (file_descriptor != -1) { ::close(file_descriptor); }
+#endif // _WIN32 end
+		}
+
+		// Opens a regular file for reading and gets its size. Returns false if the file can't be
+		// opened or if it is not a regular file.
+		bool open(const std::filesystem::path& filename, std::uintmax_t& size)
+		{
+#if defined(_WIN32)
+			// opening a directory fails without FILE_FLAG_BACKUP_SEMANTICS
+			file_handle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+									  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file_handle == INVALID_HANDLE_VALUE) { return false; }
+
+			LARGE_INTEGER file_size {};
+			if (GetFileSizeEx(file_handle, &file_size) == 0) { return false; } // GCOVR_EXCL_LINE
+			size = static_cast<std::uintmax_t>(file_size.QuadPart);
+			return true;
+#else
+			file_descriptor = ::open(filename.c_str(), O_RDONLY);
+			if (file_descriptor == -1) { return false; }
+
+			// a single fstat gives us both the file type and the file size
+			struct stat file_status {};
+			if ((fstat(file_descriptor, &file_status) != 0) || (!S_ISREG(file_status.st_mode)))
+			{
+				return false;
+			}
+			size = static_cast<std::uintmax_t>(file_status.st_size);
+			return true;
+#endif // _WIN32 end
+		}
+
+		// Reads up to size bytes from the file to the data. The read_size is set to the number of
+		// bytes read, that can be less than size if the end of the file is reached. Returns false
+		// if there was an error while reading.
+		bool read(char* data, const size_t size, size_t& read_size)
+		{
+			read_size = 0;
+			while (read_size < size)
+			{
+#if defined(_WIN32)
+				// ReadFile can only read up to the maximum value of a DWORD each time
+				size_t remaining = size - read_size;
+				const size_t max_read = 1024 * 1024 * 1024;
+				if (remaining > max_read) { remaining = max_read; } // GCOVR_EXCL_LINE
+
+				DWORD bytes_read = 0;
+				if (ReadFile(file_handle, data + read_size, static_cast<DWORD>(remaining),
+							 &bytes_read, nullptr) == 0)
+				{
+					return false; // GCOVR_EXCL_LINE
+				}
+#else
+				const auto bytes_read = ::read(file_descriptor, data + read_size,
+											   size - read_size);
+				if (bytes_read < 0)
+				{
+					// the read was interrupted by a signal before reading anything so try again
+					if (errno == EINTR) { continue; } // GCOVR_EXCL_LINE
+					return false; // GCOVR_EXCL_LINE
+				}
+#endif // _WIN32 end
+
+				// the end of the file was reached, the file is smaller than it used to be
+				if (bytes_read == 0) { break; } // GCOVR_EXCL_LINE
+				read_size += static_cast<size_t>(bytes_read);
+			}
+			return true;
+		}
+	};
+
+	// Resizes the string and lets the operation write the characters. The operation takes a
+	// pointer to the characters and the size, and returns how many characters it has written,
+	// the string is then resized to that size. When std::string::resize_and_overwrite is available
+	// the characters are never initialized before the operation overwrites them.
+	template<typename Operation>
+	inline void resize_and_overwrite(std::string& value, const size_t size, Operation operation)
+	{
+#if defined(__cpp_lib_string_resize_and_overwrite)
+		value.resize_and_overwrite(size, operation);
+#else
+		value.resize(size);
+		value.resize(operation(value.data(), size));
+#endif // __cpp_lib_string_resize_and_overwrite end
+	}
+
+	// Opens a file, finds its size and calls the operation with the opened file and its size to
+	// read it. Returns false if the file can't be opened or if it is too large to be held in
+	// memory, otherwise it returns what the operation returns. The operation isn't called for an
+	// empty file.
+	template<typename Operation>
+	inline bool read_native_file(const std::filesystem::path& filename, Operation operation)
+	{
+		// the file is closed when it goes out of scope even if an exception is thrown
+		mtl::filesystem::detail::native_file in_file;
+		// exact file size in bytes
+		std::uintmax_t size = 0;
+
+		// if we can't open the file or it isn't a regular file it is an error
+		if (in_file.open(filename, size) == false) { return false; }
+
+		// if filesize is 0 then just leave and report success as there is nothing to be read
+		if (size == 0) { return true; }
+
+		// check if we are compiling in 64 bit mode, for gcc and clang we detect 64 bit compilation
+		// with the macro __LP64__ and for MSVC with the macro _WIN64
+#if !defined(__LP64__) && !defined(_WIN64)
+		// when compiling in 32 bit mode size_t it is way smaller than std::uintmax_t so we have to
+		// check and not allow file to be read if is beyond what size_t can hold as we can't resize
+		// the output beyond size_t for an std::string, this usually will not happen as 32 bit OS
+		// can't use files beyond 4GB but better be safe than sorry
+
+		// thow an assert in debug mode to alert the user
+		MTL_ASSERT_MSG((size <= std::numeric_limits<size_t>::max()),
+		"Error in mtl::filesystem::read_file. File too large for 32 bit operating system.");
+
+		// return false to indicate that the file was not read because of size
+		if (size > std::numeric_limits<size_t>::max()) { return false; }
+#endif // __LP64__ end
+
+		return operation(in_file, static_cast<size_t>(size));
+	}
+
+	// Reads an entire file to an std::string. Same as mtl::filesystem::read_file but without the
+	// assert that checks the file exists, so it can be used for files that may not exist.
+	inline bool read_file_impl(const std::filesystem::path& filename, std::string& read_data)
+	{
+		return mtl::filesystem::detail::read_native_file(filename,
+		[&read_data](native_file& in_file, const size_t size)
+		{
+			bool success = true;
+			// read the file directly to the output, if the file became smaller since we got its
+			// size the output is resized to the number of bytes actually read
+			mtl::filesystem::detail::resize_and_overwrite(read_data, size,
+			[&in_file, &success](char* data, const size_t data_size)
+			{
+				size_t read_size = 0;
+				success = in_file.read(data, data_size, read_size);
+				return read_size;
+			});
+			return success;
+		});
+	}
+
+} // namespace detail end
+
+
 /// Read an entire file to an std::string. The filename is used to specify which file to read.
 /// The read_data is where the read file will be stored. Returns if the file was read successfully.
+/// The file is opened, and its type and size are found, with a single call to the operating system
+/// each. In debug builds where MTL_DISABLE_SOME_ASSERTS isn't defined the file is also checked
+/// with std::filesystem::is_regular_file for an assert, which is an additional call. The file is
+/// then read directly to the std::string. When std::string::resize_and_overwrite is available the
+/// std::string isn't filled with zeroes before it is read, otherwise use the overload for
+/// mtl::filesystem::file_buffer that never fills the memory with zeroes. The size of the
+/// read_data is the number of bytes that were read.
 /// @param[in] filename The relative or absolute path to a file.
 /// @param[out] read_data An std::string where the read file will be stored.
 /// @return Returns if the file was read successfully.
 inline bool read_file(const std::filesystem::path& filename, std::string& read_data)
 {
 
-#ifndef MTL_DISABLE_SOME_ASSERTS
-	// when in debug mode check the file we want to open exists and assert if it doesn't
-	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
-				   "File doesn't exist or incorrect path given.");
-#endif // MTL_DISABLE_SOME_ASSERTS end
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	return mtl::filesystem::detail::read_file_impl(filename, read_data);
+}
+
+
+
+// ================================================================================================
+// FILE_BUFFER      - Owning buffer of the contents of a file.
+// ================================================================================================
+
+
+/// Owns the entire contents of a file. Filled by mtl::filesystem::read_file with a single heap
+/// allocation that, unlike an std::string before C++23, is never filled with zeroes before the
+/// file is read to it. It can't be copied but it can be moved.
+class file_buffer
+{
+	// the contents of the file
+	std::unique_ptr<char[]> buffer;
+	// the size of the contents of the file
+	size_t buffer_size = 0;
+
+	friend bool read_file(const std::filesystem::path& filename, file_buffer& read_data);
+
+public:
+
+
+	// ============================================================================================
+	// DATA             - Returns a pointer to the contents of the file.
+	// ============================================================================================
+
+	/// Returns a pointer to the contents of the file or nullptr if it is empty.
+	/// @return A pointer to the contents of the file.
+	[[nodiscard]]
+	const char* data() const noexcept { return buffer.get(); }
+
+
+	// ============================================================================================
+	// SIZE             - Returns the size of the contents of the file in bytes.
+	// ============================================================================================
+
+	/// Returns the size of the contents of the file in bytes.
+	/// @return The size of the contents of the file.
+	[[nodiscard]]
+	size_t size() const noexcept { return buffer_size; }
+
+
+	// ============================================================================================
+	// EMPTY            - Returns if the contents of the file are empty.
+	// ============================================================================================
+
+	/// Returns if the contents of the file are empty.
+	/// @return If the contents of the file are empty.
+	[[nodiscard]]
+	bool empty() const noexcept { return buffer_size == 0; }
+
+
+	// ============================================================================================
+	// VIEW             - Returns an std::string_view of the contents of the file.
+	// ============================================================================================
+
+	/// Returns an std::string_view to the entire contents of the file.
+	/// @return An std::string_view to the contents of the file.
+	[[nodiscard]]
+	std::string_view view() const noexcept
+	{
+		return std::string_view(buffer.get(), buffer_size);
+	}
+
+
+	// ============================================================================================
+	// CLEAR            - Releases the contents of the file.
+	// ============================================================================================
+
+	/// Releases the contents of the file.
+	void clear() noexcept
+	{
+		buffer.reset();
+		buffer_size = 0;
+	}
+};
+
+
+/// Read an entire file to an mtl::filesystem::file_buffer. The filename is used to specify which
+/// file to read. The read_data is where the read file will be stored, replacing anything it held
+/// before. Returns if the file was read successfully. Works like the overload for std::string,
+/// but the memory the file is read to is never filled with zeroes. The size of the read_data is
+/// the number of bytes that were read.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[out] read_data An mtl::filesystem::file_buffer where the read file will be stored.
+/// @return Returns if the file was read successfully.
+inline bool read_file(const std::filesystem::path& filename, file_buffer& read_data)
+{
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	read_data.clear();
+
+	return mtl::filesystem::detail::read_native_file(filename,
+	[&read_data](mtl::filesystem::detail::native_file& in_file, const size_t size)
+	{
+		// the buffer is not zero initialized as it is going to be overwritten anyway
+		read_data.buffer.reset(new char[size]);
+		size_t read_size = 0;
+		const bool success = in_file.read(read_data.buffer.get(), size, read_size);
+		// if the file became smaller since we got its size only the bytes read are kept
+		read_data.buffer_size = read_size;
+		return success;
+	});
+}
+
+
+
+// ================================================================================================
+// READ_ALL_LINES   - Reads all lines from a file to a container of strings.
+// ================================================================================================
+
+
+namespace detail
+{
+	// Splits the given string at newlines and stores them to the given container. Specialized
+	// string splitting algorithm that takes into account both LF and CRLF characters when
+	// splitting at newlines. All newlines are found in a single pass that uses SIMD when it is
+	// available.
+	template<typename Container>
+	inline void specialized_split_crlf(std::string_view read_data, Container& split_lines)
+	{	
+		// remember the starting position
+		size_t start = 0;
+
+		// add all tokens to the container except the last one
+		mtl::detail::for_each_char(read_data.data(), read_data.size(), '\n',
+		[&read_data, &split_lines, &start](const size_t match_pos)
+		{
+			auto token_size = match_pos - start;
+			// crlf case, remove the \r before the \n
+			if ((token_size > 0) && (read_data[match_pos - 1] == '\r'))
+			{
+				--token_size;
+			}
+			mtl::emplace_back(split_lines, read_data.substr(start, token_size));
+			// set the new starting position
+			start = match_pos + 1;
+		});
+
+		// add the last item, if there were no newlines at all this adds the entire input string
+		mtl::emplace_back(split_lines, read_data.substr(start));
+	}
+
+} // namespace detail end
+
+
+/// Read an entire file in lines. The filename is used to specify which file to read. The 
+/// read_lines is where the file will be placed. Allows you to reserve memory for the container. 
+/// The container element type has to be std::string. Returns if the file was read successfully. 
+/// The file is memory mapped and split directly, so it is never copied to an intermediate buffer.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[out] read_lines A container with element type std::string to store the read lines.
+/// @return Returns if all the lines were read successfully.
+template<typename Container>
+inline bool read_all_lines(const std::filesystem::path& filename, Container& read_lines)
+{
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	mtl::filesystem::mapped_file file;
+	// try to map the file, means we couldn't read the file for some reason
+	if (file.open(filename) == false)
+	{
+		return false;
+	}
+
+	// check that the file is not empty before we try to split it
+	if (file.empty() == false)
+	{
+		// split each line to an output container at each newline
+		mtl::filesystem::detail::specialized_split_crlf(file.view(), read_lines);
+		// if the last element is empty remove it, we are sure that the output is not empty
+		// become we know that the file is bigger than 0 if we reached this point
+		if (read_lines.back().empty())
+		{
+			read_lines.pop_back();
+		}
+	}
+
+	// if we are here means everything went fine
+	return true;
+}
+
+
+
+// ================================================================================================
+// READ_ALL_LINES_PAR - Reads all lines from a file to a container of strings in parallel.
+// ================================================================================================
+
+namespace detail
+{
+	// Files smaller than this size in bytes are always split into lines serially, as the cost of
+	// starting threads is larger than the time it takes to split them.
+	constexpr size_t parallel_lines_threshold = 1024 * 1024;
+
+	// The smallest size in bytes of each chunk of the file that a single thread splits into lines.
+	constexpr size_t parallel_lines_min_chunk = 256 * 1024;
+
+	// Returns the positions where each chunk of the given string starts, with the size of the
+	// string as the last position. Each chunk, except the first, starts right after a newline so
+	// that no line and no CRLF is split between two chunks.
+	inline std::vector<size_t> newline_chunks(std::string_view read_data, const size_t chunks)
+	{
+		std::vector<size_t> boundaries;
+		boundaries.reserve(chunks + 1);
+		boundaries.push_back(0);
+
+		for (size_t i = 1; i < chunks; ++i)
+		{
+			// the ideal position for the chunk to start if all chunks were the same size
+			size_t position = (read_data.size() / chunks) * i;
+			if (position < boundaries.back())
+			{
+				position = boundaries.back();
+			}
+
+			const auto newline = read_data.find('\n', position);
+			// there are no more newlines so the rest of the string belongs to the last chunk
+			if ((newline == std::string_view::npos) || (newline + 1 >= read_data.size()))
+			{
+				break;
+			}
+
+			if (newline + 1 > boundaries.back())
+			{
+				boundaries.push_back(newline + 1);
+			}
+		}
+
+		boundaries.push_back(read_data.size());
+		return boundaries;
+	}
+
+} // namespace detail end
+
+
+/// Read an entire file in lines using multiple threads. The filename is used to specify which file
+/// to read. The read_lines is where the file will be placed. The container element type has to be
+/// std::string. The file is split into chunks that start right after a newline, each chunk is
+/// split into lines on a different thread and the lines are placed to the container in the same
+/// order they appear in the file. Files smaller than 1 MiB are always read using a single thread.
+/// The output is exactly the same as mtl::filesystem::read_all_lines. Returns if the file was read
+/// successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[out] read_lines A container with element type std::string to store the read lines.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
+/// @return Returns if all the lines were read successfully.
+template<typename Container>
+inline bool read_all_lines_par(const std::filesystem::path& filename, Container& read_lines,
+							   const size_t threads = 0)
+{
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	mtl::filesystem::mapped_file file;
+	// try to map the file, means we couldn't read the file for some reason
+	if (file.open(filename) == false)
+	{
+		return false;
+	}
+
+	// an empty file has no lines
+	if (file.empty())
+	{
+		return true;
+	}
+
+	const std::string_view read_data = file.view();
+
+	// never use more chunks than the file size allows so every thread has enough work to do
+	size_t chunks = mtl::detail::parallel_thread_count(threads);
+	const size_t max_chunks = read_data.size() / mtl::filesystem::detail::parallel_lines_min_chunk;
+	if (chunks > max_chunks)
+	{
+		chunks = max_chunks;
+	}
+
+	// for small files splitting serially is faster than starting threads
+	if ((read_data.size() < mtl::filesystem::detail::parallel_lines_threshold) || (chunks < 2))
+	{
+		mtl::filesystem::detail::specialized_split_crlf(read_data, read_lines);
+	}
+	else
+	{
+		const std::vector<size_t> boundaries =
+		mtl::filesystem::detail::newline_chunks(read_data, chunks);
+		const size_t parts_size = boundaries.size() - 1;
+
+		// each thread splits its own chunk of the file to its own container
+		std::vector<std::vector<std::string>> parts(parts_size);
+		mtl::detail::run_parallel(parts_size,
+		[&read_data, &boundaries, &parts, parts_size](const size_t index)
+		{
+			const auto chunk = read_data.substr(boundaries[index],
+												boundaries[index + 1] - boundaries[index]);
+			mtl::filesystem::detail::specialized_split_crlf(chunk, parts[index]);
+			// all chunks except the last end with a newline so splitting them adds an empty
+			// element at the end that isn't an actual line
+			if (index + 1 < parts_size)
+			{
+				parts[index].pop_back();
+			}
+		});
+
+		// place all lines to the output container in the order they appear in the file
+		size_t total_lines = 0;
+		for (const auto& part : parts)
+		{
+			total_lines += part.size();
+		}
+		mtl::reserve(read_lines, read_lines.size() + total_lines);
+
+		for (auto& part : parts)
+		{
+			for (auto& line : part)
+			{
+				mtl::emplace_back(read_lines, std::move(line));
+			}
+		}
+	}
+
+	// if the last element is empty remove it, we are sure that the output is not empty because we
+	// know that the file is bigger than 0 if we reached this point
+	if (read_lines.back().empty())
+	{
+		read_lines.pop_back();
+	}
+
+	// if we are here means everything went fine
+	return true;
+}
+
+
+
+// ================================================================================================
+// READ_FILES_PAR   - Reads many files to strings using multiple threads.
+// ================================================================================================
+
+
+/// Read many files to std::string using multiple threads. The filenames are used to specify which
+/// files to read. The read_data is where the files will be stored, with the file at each position
+/// of the filenames stored at the same position of read_data. The read_success contains for each
+/// file if it was read successfully. A fixed number of threads take files one at a time until all
+/// files are read, so many small files are read concurrently. Files that don't exist or can't be
+/// read are marked as failed without stopping the rest from being read. Returns if all the files
+/// were read successfully.
+/// @param[in] filenames The relative or absolute paths to the files.
+/// @param[out] read_data An std::vector of std::string where the read files will be stored.
+/// @param[out] read_success An std::vector of bool with the success of reading each file.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
+/// @return Returns if all the files were read successfully.
+inline bool read_files_par(const std::vector<std::filesystem::path>& filenames,
+						   std::vector<std::string>& read_data, std::vector<bool>& read_success,
+						   const size_t threads = 0)
+{
+	const size_t files_size = filenames.size();
+	read_data.assign(files_size, std::string());
+	read_success.assign(files_size, false);
+	if (files_size == 0) { return true; }
+
+	// never start more threads than there are files
+	size_t threads_size = mtl::detail::parallel_thread_count(threads);
+	if (threads_size > files_size)
+	{
+		threads_size = files_size;
+	}
+
+	// elements of std::vector<bool> can't be written from different threads at the same time
+	std::vector<char> success(files_size, 0);
+	// the index of the next file that hasn't been taken by a thread yet
+	std::atomic<size_t> next_file { 0 };
+
+	mtl::detail::run_parallel(threads_size,
+	[&filenames, &read_data, &success, &next_file, files_size](const size_t)
+	{
+		size_t index = next_file.fetch_add(1);
+		while (index < files_size)
+		{
+			if (mtl::filesystem::detail::read_file_impl(filenames[index], read_data[index]))
+			{
+				success[index] = 1;
+			}
+			index = next_file.fetch_add(1);
+		}
+	});
+
+	bool all_read = true;
+	for (size_t i = 0; i < files_size; ++i)
+	{
+		read_success[i] = (success[i] == 1);
+		if (success[i] == 0) { all_read = false; }
+	}
+	return all_read;
+}
+
+/// Read all regular files in a directory, for which the filter returns true, to std::string using
+/// multiple threads. Subdirectories are not searched. The filter is a function that takes an
+/// std::filesystem::path and returns a bool. The filenames is where the paths to the selected
+/// files are stored, sorted by their name. The read_data and read_success are the same as
+/// mtl::filesystem::read_files_par. Returns false if the directory can't be opened or if any of
+/// the files wasn't read successfully.
+/// @param[in] directory The relative or absolute path to a directory.
+/// @param[in] filter A function that returns if a file should be read.
+/// @param[out] filenames An std::vector of std::filesystem::path where the paths are stored.
+/// @param[out] read_data An std::vector of std::string where the read files will be stored.
+/// @param[out] read_success An std::vector of bool with the success of reading each file.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
+/// @return Returns if the directory was opened and all the files were read successfully.
+template<typename Function>
+inline bool read_files_par(const std::filesystem::path& directory, Function&& filter,
+						   std::vector<std::filesystem::path>& filenames,
+						   std::vector<std::string>& read_data, std::vector<bool>& read_success,
+						   const size_t threads = 0)
+{
+	filenames.clear();
+
+	// create an std::error_code object so we can call the noexcept versions
+	std::error_code error_code;
+	std::filesystem::directory_iterator it(directory, error_code);
+	if (error_code)
+	{
+		read_data.clear();
+		read_success.clear();
+		return false;
+	}
+
+	for (; it != std::filesystem::directory_iterator(); it.increment(error_code))
+	{
+		if (error_code) { break; } // GCOVR_EXCL_LINE
+		if (it->is_regular_file(error_code) && filter(it->path()))
+		{
+			filenames.push_back(it->path());
+		}
+	}
+
+	// the order of the files in a directory depends on the filesystem so sort them
+	std::sort(filenames.begin(), filenames.end());
+
+	return mtl::filesystem::read_files_par(filenames, read_data, read_success, threads);
+}
+
+
+// ================================================================================================
+// FILE_LINES       - Owning buffer of a file along with views to each line.
+// ================================================================================================
+
+
+/// Owns the entire contents of a file and holds an std::string_view for each of its lines. Lines
+/// have their LF / CRLF removed the same way as mtl::filesystem::read_all_lines. Filled by
+/// mtl::filesystem::read_all_lines while performing exactly two heap allocations, one for the
+/// contents and one for the line views, regardless of the number of lines. The line views remain
+/// valid when the object is moved, but it can't be copied.
+class file_lines
+{
+	// the contents of the file
+	std::unique_ptr<char[]> buffer;
+	// the size of the contents of the file
+	size_t buffer_size = 0;
+	// views to each line inside the buffer
+	std::vector<std::string_view> lines;
+
+	friend bool read_all_lines(const std::filesystem::path& filename, file_lines& read_lines);
+
+public:
+
+	/// Iterator type for iterating the lines.
+	using const_iterator = std::vector<std::string_view>::const_iterator;
+	/// Iterator type for iterating the lines.
+	using iterator = const_iterator;
+	/// The type of each line.
+	using value_type = std::string_view;
+
+
+	// ============================================================================================
+	// BEGIN            - Returns an iterator to the first line.
+	// ============================================================================================
+
+	/// Returns an iterator to the first line.
+	/// @return An iterator to the first line.
+	[[nodiscard]]
+	const_iterator begin() const noexcept { return lines.begin(); }
+
+
+	// ============================================================================================
+	// END              - Returns an iterator past the last line.
+	// ============================================================================================
+
+	/// Returns an iterator past the last line.
+	/// @return An iterator past the last line.
+	[[nodiscard]]
+	const_iterator end() const noexcept { return lines.end(); }
+
+
+	// ============================================================================================
+	// SIZE             - Returns the number of lines.
+	// ============================================================================================
+
+	/// Returns the number of lines.
+	/// @return The number of lines.
+	[[nodiscard]]
+	size_t size() const noexcept { return lines.size(); }
+
+
+	// ============================================================================================
+	// EMPTY            - Returns if there are no lines.
+	// ============================================================================================
+
+	/// Returns if there are no lines.
+	/// @return If there are no lines.
+	[[nodiscard]]
+	bool empty() const noexcept { return lines.empty(); }
+
+	/// Returns the line at the given index. No bounds checking is performed.
+	/// @param[in] index The index of the line.
+	/// @return An std::string_view to the line.
+	[[nodiscard]]
+	std::string_view operator[](const size_t index) const noexcept { return lines[index]; }
+
+
+	// ============================================================================================
+	// TEXT             - Returns an std::string_view of the contents of the file.
+	// ============================================================================================
+
+	/// Returns an std::string_view to the entire contents of the file.
+	/// @return An std::string_view to the contents of the file.
+	[[nodiscard]]
+	std::string_view text() const noexcept 
+	{ 
+		return std::string_view(buffer.get(), buffer_size); 
+	}
+
+
+	// ============================================================================================
+	// CLEAR            - Removes all lines and releases the contents of the file.
+	// ============================================================================================
+
+	/// Removes all lines and releases the contents of the file.
+	void clear() noexcept
+	{
+		lines.clear();
+		buffer.reset();
+		buffer_size = 0;
+	}
+};
+
+
+/// Read an entire file in lines. The filename is used to specify which file to read. The
+/// read_lines is where the contents of the file and the lines will be placed, replacing anything
+/// it held before. Each line is an std::string_view to the contents of the file so no heap
+/// allocation is performed for each line. Returns if the file was read successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[out] read_lines An mtl::filesystem::file_lines to store the contents and the lines.
+/// @return Returns if all the lines were read successfully.
+inline bool read_all_lines(const std::filesystem::path& filename, file_lines& read_lines)
+{
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	read_lines.clear();
+
+	const bool success = mtl::filesystem::detail::read_native_file(filename,
+	[&read_lines](mtl::filesystem::detail::native_file& in_file, const size_t size)
+	{
+		// read the file directly to a buffer we own, the buffer is not zero initialized as it is
+		// going to be overwritten anyway
+		read_lines.buffer.reset(new char[size]);
+		size_t read_size = 0;
+		const bool read_correctly = in_file.read(read_lines.buffer.get(), size, read_size);
+		// if the file became smaller since we got its size only the bytes read are kept
+		read_lines.buffer_size = read_size;
+		return read_correctly;
+	});
+
+	// means we couldn't read the file for some reason
+	if (success == false)
+	{
+		read_lines.clear();
+		return false;
+	}
+
+	// if the file is empty there are no lines
+	const size_t size = read_lines.buffer_size;
+	if (size == 0) { return true; }
+
+	const char* const first = read_lines.buffer.get();
+	auto& lines = read_lines.lines;
+
+	// the number of lines is always one more than the number of newlines, so by counting the
+	// newlines we can reserve the exact space needed with a single allocation
+	lines.reserve(mtl::detail::count_char(first, size, '\n') + 1);
+
+	// find all newlines in a single pass and add the line before each one of them
+	size_t start = 0;
+	mtl::detail::for_each_char(first, size, '\n', [first, &lines, &start](const size_t match_pos)
+	{
+		auto line_size = match_pos - start;
+		// crlf case, remove the \r before the \n
+		if ((line_size > 0) && (first[match_pos - 1] == '\r'))
+		{
+			--line_size;
+		}
+		lines.emplace_back(first + start, line_size);
+		start = match_pos + 1;
+	});
+
+	// add the last line, like mtl::filesystem::read_all_lines if it is empty it is not added
+	if (start != size)
+	{
+		lines.emplace_back(first + start, size - start);
+	}
+
+	return true;
+}
+
+
+
+// ================================================================================================
+// LINE_READER      - Reads a file line by line in fixed size chunks.
+// FOR_EACH_LINE    - Calls a function for each line of a file read in fixed size chunks.
+// ================================================================================================
+
+
+/// Reads a file line by line using fixed size chunks, so files of any size can be processed while
+/// using a constant amount of memory. Only a single chunk and the partial line carried over from
+/// the previous chunk are kept in memory. Lines have their LF / CRLF removed the same way as
+/// mtl::filesystem::read_all_lines. It can't be copied but it can be moved.
+class line_reader
+{
+	// the file we read from
+	std::ifstream in_file;
+	// holds the current chunk along with any partial line carried over from the previous chunk
+	std::vector<char> buffer;
+	// how many bytes to read from the file each time
+	size_t bytes_per_chunk = default_chunk_size;
+	// the start of the data in the buffer that haven't been returned as lines yet
+	size_t position = 0;
+	// the number of valid bytes in the buffer
+	size_t filled = 0;
+	// the position in the buffer up to where we already searched for a newline
+	size_t searched = 0;
+	// if we reached the end of the file
+	bool end_of_file = false;
+
+	// Moves the partial line to the start of the buffer and reads the next chunk after it. Returns
+	// false if there is nothing more to read from the file.
+	bool read_chunk()
+	{
+		// move the partial line to the start of the buffer to make space for the next chunk
+		const size_t remaining = filled - position;
+		if ((position > 0) && (remaining > 0))
+		{
+			std::memmove(buffer.data(), buffer.data() + position, remaining);
+		}
+		searched = searched - position;
+		position = 0;
+		filled = remaining;
+
+		// make sure there is space for an entire chunk after the partial line, the buffer only
+		// grows beyond the chunk size if a single line is larger than the chunk size
+		if ((buffer.size() - filled) < bytes_per_chunk)
+		{
+			buffer.resize(filled + bytes_per_chunk);
+		}
+
+		in_file.read(buffer.data() + filled, static_cast<std::streamsize>(bytes_per_chunk));
+		const auto read_size = static_cast<size_t>(in_file.gcount());
+		filled += read_size;
+		return (read_size > 0);
+	}
+
+public:
+
+	/// The default size of each chunk in bytes.
+	static constexpr size_t default_chunk_size = 65536;
+
+	/// Default constructor. Doesn't open any file.
+	line_reader() = default;
+
+	/// Constructor that opens a file. Use is_open to check if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] chunk_size The size of each chunk in bytes.
+	explicit line_reader(const std::filesystem::path& filename,
+						 const size_t chunk_size = default_chunk_size)
+	{
+		open(filename, chunk_size);
+	}
+
+
+	// ============================================================================================
+	// OPEN             - Opens a file for reading line by line.
+	// ============================================================================================
+
+	/// Opens a file for reading line by line. If another file is already open it is closed first.
+	/// The chunk_size sets how many bytes are read from the file each time, if it is 0 the
+	/// default chunk size is used. Returns if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] chunk_size The size of each chunk in bytes.
+	/// @return Returns if the file was opened successfully.
+	bool open(const std::filesystem::path& filename, const size_t chunk_size = default_chunk_size)
+	{
+		close();
+
+		// a chunk size of 0 would never read anything so use the default instead
+		if (chunk_size == 0)
+		{
+			bytes_per_chunk = default_chunk_size;
+		}
+		else
+		{
+			bytes_per_chunk = chunk_size;
+		}
+
+		// set the mask to binary mode so it works better in Windows when reading newlines
+		in_file.open(filename, std::ios::in | std::ios::binary);
+		if (in_file.is_open() == false) { return false; }
+
+		// enable exceptions for std::ifstream, do not use std::ifstream::failbit as it is set
+		// when EOF is reached and it throws an exception even when there is no actual error
+		in_file.exceptions(std::ifstream::badbit);
+		return true;
+	}
+
+
+	// ============================================================================================
+	// CLOSE            - Closes the file.
+	// ============================================================================================
+
+	/// Closes the file and releases the buffer.
+	void close()
+	{
+		if (in_file.is_open())
+		{
+			in_file.close();
+		}
+		in_file.clear();
+		buffer = std::vector<char>();
+		position = 0;
+		filled = 0;
+		searched = 0;
+		end_of_file = false;
+	}
+
+
+	// ============================================================================================
+	// IS_OPEN          - Returns if a file is open.
+	// ============================================================================================
+
+	/// Returns if a file is open.
+	/// @return If a file is open.
+	[[nodiscard]]
+	bool is_open() const
+	{
+		return in_file.is_open();
+	}
+
+
+	// ============================================================================================
+	// READ_LINE        - Reads the next line.
+	// ============================================================================================
+
+	/// Reads the next line from the file. The line is an std::string_view that is valid until the
+	/// next time read_line is called or the file is closed. Returns false when there are no more
+	/// lines to read or the file is not open.
+	/// @param[out] line An std::string_view where the next line will be stored.
+	/// @return Returns if a line was read.
+	bool read_line(std::string_view& line)
+	{
+		if (in_file.is_open() == false) { return false; }
+
+		while (true)
+		{
+			// search for a newline only in the part of the buffer we didn't search before
+			const void* match = nullptr;
+			if (filled > searched)
+			{
+				match = std::memchr(buffer.data() + searched, '\n', filled - searched);
+			}
+
+			if (match != nullptr)
+			{
+				const char* newline = static_cast<const char*>(match);
+				const char* first = buffer.data() + position;
+				auto line_size = static_cast<size_t>(newline - first);
+				// crlf case, remove the \r before the \n
+				if ((line_size > 0) && (*(newline - 1) == '\r'))
+				{
+					--line_size;
+				}
+				line = std::string_view(first, line_size);
+				position = static_cast<size_t>(newline - buffer.data()) + 1;
+				searched = position;
+				return true;
+			}
+
+			// everything in the buffer was searched
+			searched = filled;
+
+			if (end_of_file)
+			{
+				// the last line doesn't end with a newline, like mtl::filesystem::read_all_lines
+				// if it is empty it is not returned
+				if (position < filled)
+				{
+					line = std::string_view(buffer.data() + position, filled - position);
+					position = filled;
+					return true;
+				}
+				return false;
+			}
+
+			if (read_chunk() == false)
+			{
+				end_of_file = true;
+			}
+		}
+	}
+};
+
+
+/// Calls a function for each line of a file. The file is read in fixed size chunks so files of
+/// any size can be processed while using a constant amount of memory. Each line is passed to the
+/// function as an std::string_view that is only valid during the call. Lines have their LF / CRLF
+/// removed the same way as mtl::filesystem::read_all_lines. Returns if the file was read
+/// successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[in] function A function that accepts an std::string_view.
+/// @param[in] chunk_size The size of each chunk in bytes.
+/// @return Returns if the file was read successfully.
+template<typename Function>
+inline bool for_each_line(const std::filesystem::path& filename, Function&& function,
+						  const size_t chunk_size = line_reader::default_chunk_size)
+{
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	mtl::filesystem::line_reader reader;
+	if (reader.open(filename, chunk_size) == false)
+	{
+		return false;
+	}
+
+	std::string_view line;
+	while (reader.read_line(line))
+	{
+		function(line);
+	}
+	return true;
+}
+
+
+
+// ================================================================================================
+// FILE_WRITER      - Writes to a file using a buffer of fixed size.
+// ================================================================================================
+
+
+namespace detail
+{
+	// A file opened for writing using the operating system's API directly, so the data aren't
+	// buffered a second time by a stream and the file can be synced to the storage device. The
+	// file is closed when the object is destroyed. It can't be copied but it can be moved.
+	class native_output_file
+	{
+#if defined(_WIN32)
+		HANDLE file_handle = INVALID_HANDLE_VALUE;
+		// if every write goes to the end of the file
+		bool append_mode = false;
+#else
+		int file_descriptor = -1;
+#endif // _WIN32 end
+
+	public:
+
+		native_output_file() = default;
+
+		~native_output_file()
+		{
+			close();
+		}
+
+		native_output_file(const native_output_file&) = delete;
+		native_output_file& operator=(const native_output_file&) = delete;
+
+		native_output_file(native_output_file&& other) noexcept
+		{
+#if defined(_WIN32)
+			std::swap(file_handle, other.file_handle);
+			append_mode = other.append_mode;
+#else
+			std::swap(file_descriptor, other.file_descriptor);
+#endif // _WIN32 end
+		}
+
+		native_output_file& operator=(native_output_file&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+#if defined(_WIN32)
+				std::swap(file_handle, other.file_handle);
+				append_mode = other.append_mode;
+#else
+				std::swap(file_descriptor, other.file_descriptor);
+#endif // _WIN32 end
+			}
+			return *this;
+		}
+
+		// Opens a file for writing, creating it if it doesn't exist. Append if set to true adds to
+		// the end of the file instead of overwriting it. Returns false if the file can't be opened.
+		bool open(const std::filesystem::path& filename, const bool append)
+		{
+			close();
+#if defined(_WIN32)
+			file_handle = CreateFileW(filename.c_str(), GENERIC_WRITE, 
+									  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+									  append ? OPEN_ALWAYS : CREATE_ALWAYS, 
+									  FILE_ATTRIBUTE_NORMAL, nullptr);
+			append_mode = append;
+			return (file_handle != INVALID_HANDLE_VALUE);
+#else
+			const int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+			file_descriptor = ::open(filename.c_str(), flags, 0666);
+			return (file_descriptor != -1);
+#endif // _WIN32 end
+		}
+
+		// Returns if a file is open.
+		bool is_open() const noexcept
+		{
+#if defined(_WIN32)
+			return (file_handle != INVALID_HANDLE_VALUE);
+#else
+			return (file_descriptor != -1);
+#endif // _WIN32 end
+		}
+
+		// Writes size bytes from the data to the file. Returns false if there was an error while
+		// writing.
+		bool write(const char* data, const size_t size)
+		{
+			size_t written_size = 0;
+			while (written_size < size)
+			{
+#if defined(_WIN32)
+				// WriteFile can only write up to the maximum value of a DWORD each time
+				size_t remaining = size - written_size;
+				const size_t max_write = 1024 * 1024 * 1024;
+				if (remaining > max_write) { remaining = max_write; } // GCOVR_EXCL_LINE
+
+				// an offset with all bits set writes to the end of the file
+				OVERLAPPED end_of_file {};
+				end_of_file.Offset = 0xFFFFFFFF;
+				end_of_file.OffsetHigh = 0xFFFFFFFF;
+
+				DWORD bytes_written = 0;
+				if (WriteFile(file_handle, data + written_size, static_cast<DWORD>(remaining),
+							  &bytes_written, append_mode ? &end_of_file : nullptr) == 0)
+				{
+					return false; // GCOVR_EXCL_LINE
+				}
+#else
+				const auto bytes_written = ::write(file_descriptor, data + written_size,
+												   size - written_size);
+				if (bytes_written < 0)
+				{
+					// the write was interrupted by a signal before writing anything so try again
+					if (errno == EINTR) { continue; } // GCOVR_EXCL_LINE
+					return false; // GCOVR_EXCL_LINE
+				}
+#endif // _WIN32 end
+				written_size += static_cast<size_t>(bytes_written);
+			}
+			return true;
+		}
+
+		// Asks the operating system to write everything it holds in memory for the file to the
+		// storage device, so the data survive a crash or a power loss. Returns if it was
+		// successful.
+		bool sync() const
+		{
+#if defined(_WIN32)
+			return (FlushFileBuffers(file_handle) != 0);
+#else
+			int result = 0;
+			do
+			{
+				result = ::fsync(file_descriptor);
+			}
+			// try again if fsync was interrupted by a signal
+			while ((result != 0) && (errno == EINTR));
+			return (result == 0);
+#endif // _WIN32 end
+		}
+
+		// Closes the file. Returns false if closing the file reported an error. Does nothing if
+		// no file is open.
+		bool close() noexcept
+		{
+			if (is_open() == false) { return true; }
+#if defined(_WIN32)
+			const bool success = (CloseHandle(file_handle) != 0);
+			file_handle = INVALID_HANDLE_VALUE;
+#else
+			// the file descriptor is released even if close reports an error so don't try again
+			const bool success = (::close(file_descriptor) == 0);
+			file_descriptor = -1;
+#endif // _WIN32 end
+			return success;
+		}
+	};
+
+} // namespace detail end
+
+
+// declared here so mtl::filesystem::file_writer can make it a friend
+class async_file_writer;
+
+/// Writes to a file using a buffer of fixed size. Data are gathered in the buffer and written to
+/// the file only when the buffer is full, when flush is called or when the file is closed. The
+/// file stays open between writes so it can be written many times without opening it again. The
+/// buffer is written with the operating system's API directly, so the data aren't copied to
+/// another buffer on the way to the file. Elements of any type convertible to std::string by
+/// mtl::string::to_string can be written and they are converted one at a time, so the memory used
+/// stays the same no matter how much data are written. Throws std::ios_base::failure if writing to
+/// the file fails. It can't be copied but it can be moved.
+class file_writer
+{
+	// the file we write to
+	mtl::filesystem::detail::native_output_file out_file;
+	// holds the data that haven't been written to the file yet
+	std::string buffer;
+	// the number of bytes the buffer can hold before it is written to the file
+	size_t max_buffered = default_buffer_size;
+
+	// allows mtl::filesystem::async_file_writer to sync the file while the background thread is
+	// writing to it
+	friend class mtl::filesystem::async_file_writer;
+
+	// Writes data to the file. Throws std::ios_base::failure if writing fails.
+	void write_to_file(const char* data, const size_t size)
+	{
+		if (out_file.write(data, size) == false)
+		{
+			throw std::ios_base::failure("Error in mtl::filesystem::file_writer. Writing to the "
+										 "file failed."); // GCOVR_EXCL_LINE
+		}
+	}
+
+	// Writes the contents of the buffer to the file and empties the buffer.
+	void write_buffer()
+	{
+		if (buffer.empty() == false)
+		{
+			// the buffer is emptied even if writing fails, so the same data aren't written twice
+			const bool success = out_file.write(buffer.data(), buffer.size());
+			buffer.clear();
+			if (success == false)
+			{
+				throw std::ios_base::failure("Error in mtl::filesystem::file_writer. Writing to "
+											 "the file failed."); // GCOVR_EXCL_LINE
+			}
+		}
+	}
+
+	// Asks the operating system to write the file to the storage device. Throws
+	// std::ios_base::failure if syncing fails.
+	void sync_file()
+	{
+		if (out_file.sync() == false)
+		{
+			throw std::ios_base::failure("Error in mtl::filesystem::file_writer. Syncing the "
+										 "file failed."); // GCOVR_EXCL_LINE
+		}
+	}
+
+public:
+
+	/// The default size of the buffer in bytes.
+	static constexpr size_t default_buffer_size = 65536;
+
+	/// Default constructor. Doesn't open any file.
+	file_writer() = default;
+
+	/// Constructor that opens a file. Use is_open to check if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] append An optional boolean to and append to the end of the file or overwrite it.
+	/// @param[in] buffer_size The size of the buffer in bytes.
+	explicit file_writer(const std::filesystem::path& filename, const bool append = false,
+						 const size_t buffer_size = default_buffer_size)
+	{
+		open(filename, append, buffer_size);
+	}
+
+	/// Destructor that writes any remaining data and closes the file. Errors can't be reported
+	/// from the destructor, so call close to know if the remaining data were written successfully.
+	~file_writer()
+	{
+		// destructors shouldn't throw so ignore any errors
+		try
+		{
+			close();
+		}
+		catch (...) // GCOVR_EXCL_LINE
+		{
+		}
+	}
+
+	file_writer(const file_writer&) = delete;
+	file_writer& operator=(const file_writer&) = delete;
+
+	/// Move constructor. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::file_writer.
+	file_writer(file_writer&& other) : out_file(std::move(other.out_file)), 
+	buffer(std::move(other.buffer)), max_buffered(other.max_buffered)
+	{
+		other.buffer.clear();
+	}
+
+	/// Move assignment operator. Any data remaining in the buffer are written and the file is
+	/// closed before taking over the other file. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::file_writer.
+	/// @return A reference to this object.
+	file_writer& operator=(file_writer&& other)
+	{
+		if (this != &other)
+		{
+			close();
+			out_file = std::move(other.out_file);
+			buffer = std::move(other.buffer);
+			max_buffered = other.max_buffered;
+			other.buffer.clear();
+		}
+		return *this;
+	}
+
+
+	// ============================================================================================
+	// OPEN             - Opens a file for writing.
+	// ============================================================================================
+
+	/// Opens a file for writing. If another file is already open it is closed first. Append if set
+	/// to true adds to the end of the file instead of overwriting it. The buffer_size sets how
+	/// many bytes are gathered before they are written to the file, if it is 0 the default buffer
+	/// size is used. Returns if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] append An optional boolean to and append to the end of the file or overwrite it.
+	/// @param[in] buffer_size The size of the buffer in bytes.
+	/// @return Returns if the file was opened successfully.
+	bool open(const std::filesystem::path& filename, const bool append = false,
+			  const size_t buffer_size = default_buffer_size)
+	{
+		close();
+
+		// a buffer size of 0 would write every element separately so use the default instead
+		if (buffer_size == 0)
+		{
+			max_buffered = default_buffer_size;
+		}
+		else
+		{
+			max_buffered = buffer_size;
+		}
+
+		// the data are written as they are, so newlines aren't converted in Windows
+		// if we can't open the file it is an error
+		if (out_file.open(filename, append) == false) { return false; } // GCOVR_EXCL_LINE
+
+		buffer.reserve(max_buffered);
+		return true;
+	}
+
+
+	// ============================================================================================
+	// CLOSE            - Writes any remaining data and closes the file.
+	// ============================================================================================
+
+	/// Writes any data remaining in the buffer to the file and closes it. If sync is set to true,
+	/// before the file is closed the operating system is asked to write the file to the storage
+	/// device, with fsync or FlushFileBuffers, so the data survive a crash. The file is closed
+	/// even if writing fails. Does nothing if no file is open.
+	/// @param[in] sync An optional boolean to sync the file to the storage device.
+	void close(const bool sync = false)
+	{
+		if (out_file.is_open() == false)
+		{
+			buffer = std::string();
+			return;
+		}
+
+		// the file is closed even if writing the remaining data or syncing throws
+		bool written = true;
+		try
+		{
+			write_buffer();
+			if (sync) { sync_file(); }
+		}
+		catch (...) // GCOVR_EXCL_LINE
+		{
+			written = false; // GCOVR_EXCL_LINE
+		}
+		const bool closed = out_file.close();
+		buffer = std::string();
+
+		if ((written == false) || (closed == false))
+		{
+			throw std::ios_base::failure("Error in mtl::filesystem::file_writer. Closing the "
+										 "file failed."); // GCOVR_EXCL_LINE
+		}
+	}
+
+
+	// ============================================================================================
+	// IS_OPEN          - Returns if a file is open.
+	// ============================================================================================
+
+	/// Returns if a file is open.
+	/// @return Returns if a file is open.
+	bool is_open() const
+	{
+		return out_file.is_open();
+	}
+
+
+	// ============================================================================================
+	// BUFFER_SIZE      - Returns the size of the buffer in bytes.
+	// ============================================================================================
+
+	/// Returns the size of the buffer in bytes.
+	/// @return The size of the buffer in bytes.
+	size_t buffer_size() const
+	{
+		return max_buffered;
+	}
+
+
+	// ============================================================================================
+	// WRITE            - Writes an element to the file.
+	// ============================================================================================
+
+	/// Writes an std::string_view to the file. Data larger than the buffer are written directly to
+	/// the file without being copied to the buffer.
+	/// @param[in] data An std::string_view to write to the file.
+	void write(std::string_view data)
+	{
+		// there isn't enough space left in the buffer so empty it
+		if ((buffer.size() + data.size()) > max_buffered)
+		{
+			write_buffer();
+		}
+
+		// the data will never fit in the buffer so write them directly
+		if (data.size() >= max_buffered)
+		{
+			write_to_file(data.data(), data.size());
+		}
+		else
+		{
+			buffer.append(data);
+		}
+	}
+
+	/// Writes a char to the file.
+	/// @param[in] character A char to write to the file.
+	void write(const char character)
+	{
+		if (buffer.size() >= max_buffered)
+		{
+			write_buffer();
+		}
+		buffer.push_back(character);
+	}
+
+	/// Writes an element to the file. The element is converted to std::string using
+	/// mtl::string::to_string.
+	/// @param[in] value An element of a type convertible to std::string by mtl::string::to_string.
+	template<typename Type>
+	std::enable_if_t<!std::is_convertible_v<const Type&, std::string_view>, void>
+	write(const Type& value)
+	{
+		write(std::string_view(mtl::string::to_string(value)));
+	}
+
+
+	// ============================================================================================
+	// WRITE_LINE       - Writes an element to the file followed by a newline.
+	// ============================================================================================
+
+	/// Writes an element to the file followed by a newline. The element can be of any type the
+	/// write function accepts.
+	/// @param[in] value The element to write to the file.
+	template<typename Type>
+	void write_line(const Type& value)
+	{
+		write(value);
+		write('\n');
+	}
+
+
+	// ============================================================================================
+	// WRITE_LINES      - Writes all elements of a range to new lines in the file.
+	// ============================================================================================
+
+	/// Writes all elements of a range to new lines in the file. Each element is followed by a
+	/// newline.
+	/// @param[in] first An iterator to the start of a range. Element type can be any type
+	///                  convertible to std::string by mtl::string::to_string.
+	/// @param[in] last An iterator to the end of a range.
+	template<typename Iter>
+	void write_lines(Iter first, Iter last)
+	{
+		for (auto it = first; it != last; ++it)
+		{
+			write_line(*it);
+		}
+	}
+
+
+	// ============================================================================================
+	// FLUSH            - Writes all the data in the buffer to the file.
+	// ============================================================================================
+
+	/// Writes all the data in the buffer to the file. If sync is set to true the operating system
+	/// is then asked to write the file to the storage device, with fsync or FlushFileBuffers, so
+	/// the data survive a crash. Does nothing if no file is open.
+	/// @param[in] sync An optional boolean to sync the file to the storage device.
+	void flush(const bool sync = false)
+	{
+		if (out_file.is_open())
+		{
+			write_buffer();
+			if (sync) { sync_file(); }
+		}
+	}
+};
+
+
+
+// ================================================================================================
+// ASYNC_FILE_WRITER - Writes to a file from a background thread.
+// ================================================================================================
 
-	// what mode to open the file
-	std::ios_base::openmode open_mode = std::ios::out;
-	// set the mask to binary mode so it works better in Windows when reading newlines
-	open_mode = (open_mode | std::ios::binary);
 
-	// std::ifstream is RAII wrapper and will close correctly if an exception is thrown
-	std::ifstream in_file(filename, open_mode);
+/// Writes to a file from a background thread. Writing only moves the data to a queue, the
+/// background thread takes everything in the queue at once and writes it to the file as a single
+/// batch. Data are written to the file in the same order they were added to the queue. When the
+/// queue is full writing blocks until the background thread has made space for the new data, so
+/// the memory used stays bounded even if data are added faster than the file can be written. It
+/// can be written from multiple threads at the same time, but it can't be opened or closed while
+/// other threads are writing to it. Data handed to the operating system may still be lost if the
+/// system crashes, unless flush or close is asked to sync them to the storage device. It can't be
+/// copied or moved.
+class async_file_writer : mtl::no_move
+{
+	// the file is written only from the background thread
+	mtl::filesystem::file_writer writer;
+	// the thread that writes the queued data to the file
+	std::thread background_thread;
+	// protects all the members below
+	mutable std::mutex queue_mutex;
+	// notifies the background thread that there are data to write or that it has to stop
+	std::condition_variable data_queued;
+	// notifies the waiting threads that there is space in the queue or that data were written
+	std::condition_variable data_written;
+	// data that haven't been written to the file yet
+	std::vector<std::string> queue;
+	// the number of bytes in the queue
+	size_t queued_bytes = 0;
+	// the number of bytes the queue can hold before writing blocks
+	size_t max_queued = default_queue_size;
+	// the number of writes added to the queue since the file was opened
+	size_t writes_queued = 0;
+	// the number of writes that are written to the file since the file was opened
+	size_t writes_finished = 0;
+	// if the background thread has to stop after writing everything in the queue
+	bool stopping = false;
+	// if writing to the file failed
+	bool failed = false;
+	// if a file is open
+	bool opened = false;
 
-	// if we can't open the file it is an error
-	if (in_file.is_open() == false) { return false; }
+	// Runs on the background thread. Writes batches of data from the queue to the file until it
+	// is told to stop and the queue is empty.
+	void write_queued()
+	{
+		std::vector<std::string> batch;
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		while (true)
+		{
+			data_queued.wait(lock, [this]() { return (queue.empty() == false) || stopping; });
+			// everything has been written so we can stop
+			if (queue.empty()) { break; }
 
-	// enable exceptions for std::ifstream, do not use std::ifstream::failbit as it is set when
-	// EOF is reached and it throws an exception even when there is no actual error
-	in_file.exceptions(std::ifstream::badbit);
+			// take everything in the queue at once so other threads can keep adding data while
+			// we are writing
+			batch.swap(queue);
+			queued_bytes = 0;
+			const size_t batch_writes = writes_queued;
+			lock.unlock();
+			// there is space in the queue again
+			data_written.notify_all();
 
-	// create an std::error_code object so we can call the noexcept version
-	std::error_code error_code;
-	// get exact file size in bytes
-	std::uintmax_t size = std::filesystem::file_size(filename, error_code);
-	// if filesize is 0 then just leave and report success as there is nothing to be read
-	if (size == 0) { return true; }
-	// if the std::error_code indicates an error or the size from std::filesystem::file_size 
-	// is equal static_cast<std::uintmax_t>(-1) then we have an error
-	auto too_big = static_cast<std::uintmax_t>(-1);
-	if ((error_code) || (size == too_big)) { return false; } // GCOVR_EXCL_LINE
-
-	// check if we are compiling in 64 bit mode, for gcc and clang we detect 64 bit compilation
-	// with the macro __LP64__ and for MSVC with the macro _WIN64
-#if defined(__LP64__) || defined(_WIN64)
-	// resize the output to be exactly the same size as the file
-	read_data.resize(size);
-#else
-	// when compiling in 32 bit mode size_t it is way smaller than std::uintmax_t so we have to
-	// check and not allow file to be read if is beyond what size_t can hold as we can't resize
-	// the output beyond size_t for an std::string, this usually will not happen as 32 bit OS
-	// can't use files beyond 4GB but better be safe than sorry
+			bool success = true;
+			try
+			{
+				for (const auto& data : batch)
+				{
+					writer.write(data);
+				}
+				writer.flush();
+			}
+			catch (...) // GCOVR_EXCL_LINE
+			{
+				success = false; // GCOVR_EXCL_LINE
+			}
+			batch.clear();
 
-	// thow an assert in debug mode to alert the user
-	MTL_ASSERT_MSG((size <= std::numeric_limits<size_t>::max()),
-	"Error in mtl::filesystem::read_file. File too large for 32 bit operating system.");
+			lock.lock();
+			if (success == false) { failed = true; } // GCOVR_EXCL_LINE
+			writes_finished = batch_writes;
+			lock.unlock();
+			data_written.notify_all();
+			lock.lock();
+		}
+	}
 
-	// return false to indicate that the file was not read because of size
-	if (size > std::numeric_limits<size_t>::max()) { return false; }
+public:
 
-	// resize the output to be exactly the same size as the file
-	read_data.resize(static_cast<size_t>(size));
-#endif // __LP64__ end
+	/// The default size of the queue in bytes.
+	static constexpr size_t default_queue_size = 1024 * 1024;
 
-	// read the file and place it in the output
-	in_file.read(read_data.data(), static_cast<std::streamsize>(size));
+	/// Default constructor. Doesn't open any file.
+	async_file_writer() = default;
 
-	// if we reached this point it means success
-	return true;
-}
+	/// Constructor that opens a file. Use is_open to check if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] append An optional boolean to and append to the end of the file or overwrite it.
+	/// @param[in] queue_size The size of the queue in bytes.
+	explicit async_file_writer(const std::filesystem::path& filename, const bool append = false,
+							   const size_t queue_size = default_queue_size)
+	{
+		open(filename, append, queue_size);
+	}
 
+	/// Destructor that writes all the queued data and closes the file.
+	~async_file_writer()
+	{
+		close();
+	}
 
 
-// ================================================================================================
-// READ_ALL_LINES   - Reads all lines from a file to a container of strings.
-// ================================================================================================
+	// ============================================================================================
+	// OPEN             - Opens a file and starts the background thread.
+	// ============================================================================================
 
+	/// Opens a file for writing and starts the background thread. If another file is already open
+	/// it is closed first. Append if set to true adds to the end of the file instead of
+	/// overwriting it. The queue_size sets how many bytes can be queued before writing blocks, if
+	/// it is 0 the default queue size is used. Returns if the file was opened successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @param[in] append An optional boolean to and append to the end of the file or overwrite it.
+	/// @param[in] queue_size The size of the queue in bytes.
+	/// @return Returns if the file was opened successfully.
+	bool open(const std::filesystem::path& filename, const bool append = false,
+			  const size_t queue_size = default_queue_size)
+	{
+		close();
 
-namespace detail
-{
-	// Splits the given string at newlines and stores them to the given container. Specialized
-	// string splitting algorithm that takes into account both LF and CRLF characters when
-	// splitting at newlines.
-	template<typename Container>
-	inline void specialized_split_crlf(const std::string& read_data, Container& split_lines)
-	{	
-		// handle the case where there is only one character and it is a newline
-		if((read_data.size() == 1) && (read_data[0] == '\n'))
+		// a queue size of 0 would block every write so use the default instead
+		if (queue_size == 0)
 		{
-			mtl::emplace_back(split_lines, std::string("")); 
-			mtl::emplace_back(split_lines, std::string("")); 
-			return;
+			max_queued = default_queue_size;
 		}
-
-		// handle the case where there is only one character and it is not a newline
-		if((read_data.size() == 1) && (read_data[0] != '\n')) // GCOVR_EXCL_LINE
+		else
 		{
-			mtl::emplace_back(split_lines, read_data); 
-			return;
+			max_queued = queue_size;
 		}
 
-		// the size of the container before we start modifying it
-		const auto original_size = split_lines.size();
+		// open the file on the calling thread so failing to open it can be reported
+		if (writer.open(filename, append) == false) { return false; } // GCOVR_EXCL_LINE
 
-		const std::string delimiter ("\n");
+		// the file is marked as open only after the thread has started, so if the thread can't
+		// be started close doesn't try to stop it
+		try
+		{
+			background_thread = std::thread([this]() { write_queued(); });
+		}
+		catch (...) // GCOVR_EXCL_LINE
+		{
+			writer.close(); // GCOVR_EXCL_LINE
+			throw; // GCOVR_EXCL_LINE
+		}
+		opened = true;
+		return true;
+	}
 
-		// remember the starting position
-		size_t start = 0;
-		// position of the first match
-		size_t match_pos = read_data.find(delimiter);
 
-		// keep the position for the last item
-		size_t last_pos = 0;
+	// ============================================================================================
+	// CLOSE            - Writes all the queued data and closes the file.
+	// ============================================================================================
 
-		// add all tokens to the container except the last one
-		while (match_pos != std::string::npos)
+	/// Waits for all the queued data to be written, stops the background thread and closes the
+	/// file. If sync is set to true, before the file is closed the operating system is asked to
+	/// write the file to the storage device, with fsync or FlushFileBuffers, so the data survive a
+	/// crash. Returns if all the data were written successfully.
+	/// @param[in] sync An optional boolean to sync the file to the storage device.
+	/// @return Returns if all the data were written successfully.
+	bool close(const bool sync = false)
+	{
 		{
-			last_pos = match_pos;	
-			// make sure match position is larger than 0
-			if(match_pos > 0)
-			{
-				// lf case
-				if(read_data[match_pos - 1] != '\r')
-				{
-					const std::string_view token(read_data.data() + start, match_pos - start);
-					mtl::emplace_back(split_lines, token);
-				}
-				// crlf case
-				else
-				{
-					const auto crlf_position = match_pos - (start + 1);
-					const std::string_view token(read_data.data() + start, crlf_position);
-					mtl::emplace_back(split_lines, token);
-				}
-			}
-			else
-			{
-				const std::string_view token(read_data.data() + start, match_pos - start);
-				mtl::emplace_back(split_lines, token);
-			}	
-			
-			// set the new starting position
-			start = match_pos + 1;
-			// find a new position in the input string if there are any matches left
-			match_pos = read_data.find(delimiter, start);
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			if (opened == false) { return true; }
+			stopping = true;
 		}
+		data_queued.notify_one();
+		background_thread.join();
 
-		// how much we added to the container
-		const auto size_difference = split_lines.size() - original_size;
-
-		// if container changed size it means there are tokens in the output
-		if(size_difference > 0)
+		bool success = (failed == false);
+		try
+		{
+			// only data that were written successfully are synced
+			writer.close(sync && success);
+		}
+		catch (...) // GCOVR_EXCL_LINE
 		{
-			// add the last item using the last position
-			const std::string_view token(read_data.data() + (last_pos + 1));
-			mtl::emplace_back(split_lines, token);
+			success = false; // GCOVR_EXCL_LINE
 		}
 
+		queue.clear();
+		queued_bytes = 0;
+		writes_queued = 0;
+		writes_finished = 0;
+		stopping = false;
+		failed = false;
+		opened = false;
+		return success;
+	}
 
-		// if the container's size didn't change at all then add the entire input string because
-		// it means there are no places that it needs to be split
-		if (size_difference == 0)
-		{ 
-			mtl::emplace_back(split_lines, read_data); 
-		}
+
+	// ============================================================================================
+	// IS_OPEN          - Returns if a file is open.
+	// ============================================================================================
+
+	/// Returns if a file is open.
+	/// @return Returns if a file is open.
+	bool is_open() const
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		return opened;
 	}
 
-} // namespace detail end
 
+	// ============================================================================================
+	// WRITE            - Adds data to the queue to be written to the file.
+	// ============================================================================================
 
-/// Read an entire file in lines. The filename is used to specify which file to read. The 
-/// read_lines is where the file will be placed. Allows you to reserve memory for the container. 
-/// The container element type has to be std::string. Returns if the file was read successfully. 
-/// @param[in] filename The relative or absolute path to a file.
-/// @param[out] read_lines A container with element type std::string to store the read lines.
-/// @return Returns if all the lines were read successfully.
-template<typename Container>
-inline bool read_all_lines(const std::filesystem::path& filename, Container& read_lines)
-{
-	std::string internal_buffer;
-	// try to read the file into the buffer
-	if (mtl::filesystem::read_file(filename, internal_buffer))
-	{
-		// check that the buffer is not empty before we try to split it
-		if (internal_buffer.empty() == false)
-		{
-			// split each line to an output container at each newline
-			mtl::filesystem::detail::specialized_split_crlf(internal_buffer, read_lines);
-			// if the last element is empty remove it, we are sure that the output is not empty
-			// become we know that the internal buffer is bigger than 0 if we reached this point
-			if (read_lines.back().empty())
-			{
-				read_lines.pop_back();
-			}
-		}
+	/// Adds data to the queue to be written to the file. If the queue is full it blocks until
+	/// there is enough space in the queue. Data larger than the queue are accepted when the queue
+	/// is empty. Returns false if no file is open or if writing to the file has failed.
+	/// @param[in] data An std::string to write to the file.
+	/// @return Returns if the data were added to the queue.
+	bool write(std::string data)
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		if ((opened == false) || stopping || failed) { return false; }
+
+		// wait until the background thread makes space in the queue
+		data_written.wait(lock, [this, &data]()
+		{
+			return queue.empty() || ((queued_bytes + data.size()) <= max_queued) || failed;
+		});
+		if (failed) { return false; } // GCOVR_EXCL_LINE
+
+		queued_bytes += data.size();
+		queue.push_back(std::move(data));
+		++writes_queued;
+		lock.unlock();
+		data_queued.notify_one();
+		return true;
 	}
-	// means we couldn't read the file for some reason
-	else
+
+
+	// ============================================================================================
+	// WRITE_LINE       - Adds data followed by a newline to the queue.
+	// ============================================================================================
+
+	/// Adds data followed by a newline to the queue to be written to the file. If the queue is
+	/// full it blocks until there is enough space in the queue. Returns false if no file is open
+	/// or if writing to the file has failed.
+	/// @param[in] data An std::string to write to the file.
+	/// @return Returns if the data were added to the queue.
+	bool write_line(std::string data)
 	{
-		return false;
+		data.push_back('\n');
+		return write(std::move(data));
 	}
-	// if we are here means everything went fine
-	return true;
-}
+
+
+	// ============================================================================================
+	// FLUSH            - Waits until all the queued data are written to the file.
+	// ============================================================================================
+
+	/// Waits until all the data added to the queue before calling flush are written to the file
+	/// and handed to the operating system. If sync is set to true the operating system is then
+	/// asked to write the file to the storage device, with fsync or FlushFileBuffers, so the data
+	/// survive a crash. Returns false if no file is open or if writing or syncing the file has
+	/// failed.
+	/// @param[in] sync An optional boolean to sync the file to the storage device.
+	/// @return Returns if all the queued data were written successfully.
+	bool flush(const bool sync = false)
+	{
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		if (opened == false) { return false; }
+
+		const size_t target = writes_queued;
+		data_written.wait(lock, [this, target]()
+		{
+			return (writes_finished >= target) || failed;
+		});
+		if (failed) { return false; } // GCOVR_EXCL_LINE
+		if (sync == false) { return true; }
+
+		// the file doesn't change until it is closed so it is safe to sync it without the lock
+		// while the background thread writes, this way other threads can keep writing while the
+		// file is synced
+		lock.unlock();
+		return writer.out_file.sync();
+	}
+};
+
 
 
 // ================================================================================================
@@ -289,8 +2255,10 @@ inline bool write_file(const std::filesystem::path& filename, const std::string&
 
 /// Write a range to new lines in a file. The filename is used to specify which file to write. The
 /// elements in the range from first to last will be written to the file. Append if set to true
-/// adds to the end of the file instead of overwriting it. Returns if the file was written
-/// successfully.
+/// adds to the end of the file instead of overwriting it. The elements are written through
+/// mtl::filesystem::file_writer so the memory used stays the same no matter the size of the range.
+/// Each element is followed by a newline, except for a range of a single empty element that
+/// writes nothing. Returns if the file was written successfully.
 /// @param[in] filename The relative or absolute path to a file.
 /// @param[in] first An iterator to the start of a range. Element type can be any type convertible
 ///                  to std::string by mtl::string::to_string.
@@ -301,22 +2269,413 @@ template<typename Iter>
 inline bool write_all_lines(const std::filesystem::path& filename, Iter first, Iter last,
 					 		const bool append = false)
 {
-	std::string internal_buffer;
-	
-	// join all the elements with \n as a delimiter to an internal_buffer
-	mtl::string::join_all(first, last, internal_buffer, '\n');
+	// the elements are converted and written one at a time through a buffer of fixed size, so
+	// there is no need to join all of them in memory first
+	mtl::filesystem::file_writer writer;
+	if (writer.open(filename, append) == false) { return false; } // GCOVR_EXCL_LINE
+
+	auto it = first;
+	if (it != last)
+	{
+		// the elements used to be joined with newlines and a newline added only when the result
+		// wasn't empty, so a range of a single empty element still writes nothing
+		const std::string first_line = mtl::string::to_string(*it);
+		++it;
+		if ((it != last) || (first_line.empty() == false))
+		{
+			writer.write_line(first_line);
+			writer.write_lines(it, last);
+		}
+	}
+	writer.close();
+
+	// if we reached this point it means we succeeded
+	return true;
+}
+
+
+
+// ================================================================================================
+// WRITE_BINARY     - Writes elements of a trivially copyable type to a binary file.
+// READ_BINARY      - Reads elements of a trivially copyable type from a binary file.
+// ================================================================================================
+
+namespace detail
+{
+	// The size in bytes of the header at the start of every binary file. It is a multiple of the
+	// alignment of most types so the elements that follow it are properly aligned when the file
+	// is memory mapped.
+	constexpr size_t binary_header_size = 32;
+
+	// The version of the binary file format.
+	constexpr unsigned char binary_version = 1;
+
+	// Returns 1 if the computer is little endian and 2 if it is big endian.
+	inline unsigned char binary_endianness() noexcept
+	{
+		const uint16_t value = 1;
+		unsigned char first_byte = 0;
+		std::memcpy(&first_byte, &value, 1);
+		if (first_byte == 1) { return 1; }
+		return 2; // GCOVR_EXCL_LINE
+	}
+
+	// Creates the header for a binary file. The header contains the characters MTLB, the version
+	// of the format, the endianness of the computer, the size of each element and the number of
+	// elements. The rest of the bytes are reserved and set to 0.
+	inline std::array<char, binary_header_size> create_binary_header(const uint64_t element_size,
+																	 const uint64_t count) noexcept
+	{
+		std::array<char, binary_header_size> header {};
+		header[0] = 'M';
+		header[1] = 'T';
+		header[2] = 'L';
+		header[3] = 'B';
+		header[4] = static_cast<char>(binary_version);
+		header[5] = static_cast<char>(binary_endianness());
+		std::memcpy(header.data() + 8, &element_size, sizeof(element_size));
+		std::memcpy(header.data() + 16, &count, sizeof(count));
+		return header;
+	}
+
+	// Checks that the header of a binary file is valid, that it was written on a computer with the
+	// same endianness, that its elements have the given size and that the file size matches the
+	// number of elements. Sets count to the number of elements. Returns if the header is valid.
+	inline bool parse_binary_header(const char* header, const std::uintmax_t file_size,
+									const size_t element_size, size_t& count) noexcept
+	{
+		if (file_size < binary_header_size) { return false; }
+
+		if ((header[0] != 'M') || (header[1] != 'T') || (header[2] != 'L') || (header[3] != 'B'))
+		{
+			return false;
+		}
+
+		if ((static_cast<unsigned char>(header[4]) != binary_version) ||
+			(static_cast<unsigned char>(header[5]) != binary_endianness()))
+		{
+			return false;
+		}
+
+		uint64_t stored_size = 0;
+		uint64_t stored_count = 0;
+		std::memcpy(&stored_size, header + 8, sizeof(stored_size));
+		std::memcpy(&stored_count, header + 16, sizeof(stored_count));
+		if (stored_size != element_size) { return false; }
+
+		// compare using division so a corrupted count can't overflow
+		const std::uintmax_t data_size = file_size - binary_header_size;
+		if ((data_size % element_size != 0) || (data_size / element_size != stored_count))
+		{
+			return false;
+		}
+
+		// when compiling in 32 bit mode the count may not fit in size_t
+		if (stored_count > static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
+		{
+			return false; // GCOVR_EXCL_LINE
+		}
+
+		count = static_cast<size_t>(stored_count);
+		return true;
+	}
+
+} // namespace detail end
+
+
+/// Write elements of a trivially copyable type to a binary file. The filename is used to specify
+/// which file to write. The elements are written as they are in memory after a small header that
+/// contains the size of each element, the number of elements and the endianness of the computer.
+/// The file can be read with mtl::filesystem::read_binary or mtl::filesystem::mapped_binary using
+/// the same element type. Returns if the file was written successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[in] data A pointer to the first element.
+/// @param[in] count The number of elements to write.
+/// @return Returns if the file was written successfully.
+template<typename Type>
+inline bool write_binary(const std::filesystem::path& filename, const Type* data,
+						 const size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<Type>,
+				  "Element type for mtl::filesystem::write_binary has to be trivially copyable.");
+
+	const auto header = mtl::filesystem::detail::create_binary_header(sizeof(Type), count);
+
+	// set the mask to binary mode so nothing is changed when writing in Windows
+	std::ofstream out_file(filename, std::ios::out | std::ios::binary);
+	// if we can't open the file it is an error
+	if (out_file.is_open() == false) { return false; } // GCOVR_EXCL_LINE
+
+	// enable exceptions for std::ofstream
+	out_file.exceptions(std::ofstream::badbit | std::ofstream::failbit);
+
+	out_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+	if (count > 0)
+	{
+		out_file.write(reinterpret_cast<const char*>(data),
+					   static_cast<std::streamsize>(count * sizeof(Type)));
+	}
+
+	// if we reached this point it means we succeeded
+	return true;
+}
+
+/// Write all elements of a contiguous container, like std::vector or std::array, of a trivially
+/// copyable type to a binary file. The filename is used to specify which file to write. Returns if
+/// the file was written successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[in] container A contiguous container with elements of a trivially copyable type.
+/// @return Returns if the file was written successfully.
+template<typename Container>
+inline bool write_binary(const std::filesystem::path& filename, const Container& container)
+{
+	return mtl::filesystem::write_binary(filename, std::data(container), std::size(container));
+}
+
+
+/// Read all elements of a trivially copyable type from a binary file written by
+/// mtl::filesystem::write_binary. The filename is used to specify which file to read. The
+/// read_data is where the elements will be stored, replacing its previous contents. Fails if the
+/// file wasn't written for elements of the same size or if it was written on a computer with
+/// different endianness. Returns if the file was read successfully.
+/// @param[in] filename The relative or absolute path to a file.
+/// @param[out] read_data An std::vector where the read elements will be stored.
+/// @return Returns if the file was read successfully.
+template<typename Type, typename Allocator>
+inline bool read_binary(const std::filesystem::path& filename,
+						std::vector<Type, Allocator>& read_data)
+{
+	static_assert(std::is_trivially_copyable_v<Type>,
+				  "Element type for mtl::filesystem::read_binary has to be trivially copyable.");
+
+#ifndef MTL_DISABLE_SOME_ASSERTS
+	// when in debug mode check the file we want to open exists and assert if it doesn't
+	MTL_ASSERT_MSG(std::filesystem::is_regular_file(filename),
+				   "File doesn't exist or incorrect path given.");
+#endif // MTL_DISABLE_SOME_ASSERTS end
+
+	mtl::filesystem::detail::native_file in_file;
+	std::uintmax_t size = 0;
+	if (in_file.open(filename, size) == false) { return false; }
+
+	std::array<char, mtl::filesystem::detail::binary_header_size> header {};
+	size_t read_size = 0;
+	if ((size < header.size()) || (in_file.read(header.data(), header.size(), read_size) == false)
+		|| (read_size != header.size()))
+	{
+		return false;
+	}
+
+	size_t count = 0;
+	if (mtl::filesystem::detail::parse_binary_header(header.data(), size, sizeof(Type), count)
+		== false)
+	{
+		return false;
+	}
 
-	if (internal_buffer.empty() == false)
+	read_data.resize(count);
+	if (count > 0)
 	{
-		internal_buffer.push_back('\n');
+		const size_t data_size = count * sizeof(Type);
+		if ((in_file.read(reinterpret_cast<char*>(read_data.data()), data_size, read_size)
+			== false) || (read_size != data_size))
+		{
+			read_data.clear(); // GCOVR_EXCL_LINE
+			return false; // GCOVR_EXCL_LINE
+		}
 	}
 
-	// write to file
-	return mtl::filesystem::write_file(filename, internal_buffer, append);
+	// if we reached this point it means success
+	return true;
 }
 
 
 
+// ================================================================================================
+// MAPPED_BINARY    - A read-only memory mapped binary file of a trivially copyable type.
+// ================================================================================================
+
+
+/// A read-only memory mapped binary file written by mtl::filesystem::write_binary. Gives access to
+/// the elements directly from the mapped memory without copying them. The element type has to be
+/// the same type used when writing the file. Elements with alignment larger than 32 bytes are not
+/// supported. It can't be copied but it can be moved.
+template<typename Type>
+class mapped_binary
+{
+	static_assert(std::is_trivially_copyable_v<Type>,
+				  "Element type for mtl::filesystem::mapped_binary has to be trivially copyable.");
+	static_assert(alignof(Type) <= mtl::filesystem::detail::binary_header_size,
+				  "Element type for mtl::filesystem::mapped_binary has too large alignment.");
+
+	// the memory mapped file
+	mtl::filesystem::mapped_file file;
+	// pointer to the first element
+	const Type* elements = nullptr;
+	// the number of elements
+	size_t elements_size = 0;
+
+public:
+
+	/// Iterator type for iterating the elements.
+	using const_iterator = const Type*;
+	/// Iterator type for iterating the elements.
+	using iterator = const_iterator;
+	/// The type of each element.
+	using value_type = Type;
+
+	/// Default constructor. Doesn't open any file.
+	mapped_binary() = default;
+
+	/// Constructor that opens and maps a binary file. Use is_open to check if the file was opened
+	/// successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	explicit mapped_binary(const std::filesystem::path& filename)
+	{
+		open(filename);
+	}
+
+	mapped_binary(const mapped_binary&) = delete;
+	mapped_binary& operator=(const mapped_binary&) = delete;
+
+	/// Move constructor. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::mapped_binary.
+	mapped_binary(mapped_binary&& other) noexcept : file(std::move(other.file)),
+	elements(other.elements), elements_size(other.elements_size)
+	{
+		other.elements = nullptr;
+		other.elements_size = 0;
+	}
+
+	/// Move assignment operator. The moved from object is left closed.
+	/// @param[in, out] other Another mtl::filesystem::mapped_binary.
+	/// @return A reference to this object.
+	mapped_binary& operator=(mapped_binary&& other) noexcept
+	{
+		if (this != &other)
+		{
+			file = std::move(other.file);
+			elements = other.elements;
+			elements_size = other.elements_size;
+			other.elements = nullptr;
+			other.elements_size = 0;
+		}
+		return *this;
+	}
+
+
+	// ============================================================================================
+	// OPEN             - Opens and maps a binary file to memory.
+	// ============================================================================================
+
+	/// Opens a binary file and maps it to memory as read-only. If another file is already open it
+	/// is closed first. Fails if the file wasn't written for elements of the same size or if it
+	/// was written on a computer with different endianness. Returns if the file was opened
+	/// successfully.
+	/// @param[in] filename The relative or absolute path to a file.
+	/// @return Returns if the file was opened and mapped successfully.
+	bool open(const std::filesystem::path& filename)
+	{
+		close();
+		if (file.open(filename) == false) { return false; }
+
+		size_t count = 0;
+		if ((file.size() < mtl::filesystem::detail::binary_header_size) ||
+			(mtl::filesystem::detail::parse_binary_header(file.data(), file.size(), sizeof(Type),
+														  count) == false))
+		{
+			file.close();
+			return false;
+		}
+
+		// the mapped memory starts at the start of a page and the header size is a multiple of
+		// the alignment of the element type, so the elements are properly aligned
+		elements = reinterpret_cast<const Type*>(file.data() +
+												 mtl::filesystem::detail::binary_header_size);
+		elements_size = count;
+		return true;
+	}
+
+
+	// ============================================================================================
+	// CLOSE            - Unmaps and closes the file.
+	// ============================================================================================
+
+	/// Unmaps and closes the file. Any pointers to the elements are invalidated.
+	void close() noexcept
+	{
+		file.close();
+		elements = nullptr;
+		elements_size = 0;
+	}
+
+
+	// ============================================================================================
+	// IS_OPEN          - Returns if a file is open.
+	// ============================================================================================
+
+	/// Returns if a file is open.
+	/// @return Returns if a file is open.
+	[[nodiscard]]
+	bool is_open() const noexcept { return file.is_open(); }
+
+
+	// ============================================================================================
+	// DATA             - Returns a pointer to the first element.
+	// ============================================================================================
+
+	/// Returns a pointer to the first element.
+	/// @return A pointer to the first element.
+	[[nodiscard]]
+	const Type* data() const noexcept { return elements; }
+
+
+	// ============================================================================================
+	// SIZE             - Returns the number of elements.
+	// ============================================================================================
+
+	/// Returns the number of elements.
+	/// @return The number of elements.
+	[[nodiscard]]
+	size_t size() const noexcept { return elements_size; }
+
+
+	// ============================================================================================
+	// EMPTY            - Returns if there are no elements.
+	// ============================================================================================
+
+	/// Returns if there are no elements.
+	/// @return If there are no elements.
+	[[nodiscard]]
+	bool empty() const noexcept { return (elements_size == 0); }
+
+
+	// ============================================================================================
+	// BEGIN            - Returns an iterator to the first element.
+	// ============================================================================================
+
+	/// Returns an iterator to the first element.
+	/// @return An iterator to the first element.
+	[[nodiscard]]
+	const_iterator begin() const noexcept { return elements; }
+
+
+	// ============================================================================================
+	// END              - Returns an iterator past the last element.
+	// ============================================================================================
+
+	/// Returns an iterator past the last element.
+	/// @return An iterator past the last element.
+	[[nodiscard]]
+	const_iterator end() const noexcept { return elements + elements_size; }
+
+	/// Returns the element at the given index. No bounds checking is performed.
+	/// @param[in] index The index of the element.
+	/// @return A reference to the element.
+	[[nodiscard]]
+	const Type& operator[](const size_t index) const noexcept { return elements[index]; }
+};
+
 
 
 } // namespace filesystem end
@@ -12,259 +12,440 @@
 
 
 #include "definitions.hpp"   // various definitions
-#include <algorithm>         // std::copy, std::fill
+#include <algorithm>         // std::copy, std::fill, std::lower_bound, std::max, std::min
 #include <string>            // std::string, std::string::npos
 #include <string_view>       // std::string_view
-#include <cstring>           // std::strlen, std::strstr, std::strchr
-#include <iterator>          // std::iterator_traits, std::next, std::advance, std::distance
-#include <utility>           // std::pair, std::forward
+#include <cstring>           // std::strlen, std::strstr, std::strchr, std::memcmp, std::memcpy,
+							 // std::memmove
+#include <iterator>          // std::iterator_traits, std::next, std::forward_iterator_tag,
+							 // std::distance
+#include <utility>           // std::pair, std::make_pair, std::forward, std::swap
 #include <cmath>             // std::floor, std::ceil
 #include <vector>            // std::vector
 #include <array>             // std::array
 #include <stdexcept>         // std::invalid_argument, std::logic_error
 #include <cstddef>           // std::ptrdiff_t
-#include <type_traits>       // std::enable_if_t, std::is_same_v, std::remove_cv_t
+#include <type_traits>       // std::enable_if_t, std::is_same_v, std::remove_cv_t,
+							 // std::is_convertible_v
 #include "type_traits.hpp"   // mtl::is_std_string_v
 #include "container.hpp"     // mtl::emplace_back
-#include "fmt_include.hpp"   // fmt::format, fmt::format_int, fmt::to_string
-#include "utility.hpp"       // MTL_ASSERT_MSG
+#include "fmt_include.hpp"   // fmt::format, fmt::format_int, fmt::to_string, fmt::format_to_n
+#include <cstdint>           // uint32_t, uint64_t
+#include <limits>            // std::numeric_limits
+#include <memory>            // std::unique_ptr
+#include <ostream>           // std::ostream, std::streamsize
+#include <thread>            // std::thread
+#include <exception>         // std::exception_ptr, std::current_exception, std::rethrow_exception
+
+
+// SIMD headers, SSE2 is part of the x86-64 baseline so it is always available there without any
+// compiler flags, AVX2 is compiled in for gcc, clang and MSVC but only used when the CPU running
+// the program supports it
+#ifndef MTL_DISABLE_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define MTL_SIMD_SSE2
+#include <emmintrin.h> // __m128i, _mm_set1_epi8, _mm_loadu_si128, _mm_cmpeq_epi8, 
+					   // _mm_movemask_epi8, _mm_sub_epi8, _mm_sad_epu8, _mm_setzero_si128,
+					   // _mm_and_si128, _mm_or_si128, _mm_xor_si128, _mm_add_epi8,
+					   // _mm_cmplt_epi8, _mm_storeu_si128
+#endif // SSE2 end
+
+#if defined(__AVX2__) || (defined(MTL_SIMD_SSE2) && (defined(__GNUC__) || defined(_MSC_VER)))
+#define MTL_SIMD_AVX2
+#include <immintrin.h> // __m256i, _mm256_set1_epi8, _mm256_loadu_si256, _mm256_cmpeq_epi8,
+					   // _mm256_movemask_epi8, _mm256_and_si256, _mm256_or_si256,
+					   // _mm256_xor_si256, _mm256_add_epi8, _mm256_cmpgt_epi8,
+					   // _mm256_storeu_si256
+#endif // AVX2 end
+
+#endif // MTL_DISABLE_SIMD end
+
+// Functions that use AVX2 are compiled for AVX2 even when the rest of the code isn't, so they can
+// be used after checking the CPU supports AVX2. MSVC allows AVX2 in any function so there it
+// isn't needed.
+#if defined(MTL_SIMD_AVX2) && !defined(__AVX2__) && defined(__GNUC__)
+#define MTL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MTL_TARGET_AVX2
+#endif // MTL_TARGET_AVX2 end
+
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward, _BitScanReverse, __cpuid, __cpuidex, _xgetbv
+#endif // _MSC_VER end
 
 
 namespace mtl
 {
 
-
-namespace string
+namespace detail
 {
 
-// ================================================================================================
-// IS_UPPER - Returns if a character is an uppercase ASCII character.
-// IS_UPPER - Returns if all characters in an std::string are uppercase ASCII characters.
-// IS_LOWER - Returns if a character is a lowercase ASCII character.
-// IS_LOWER - Returns if all characters in an std::string are lowercase ASCII characters.
-// ================================================================================================
+// ------------------------------------------------------------------------------------------------
+// Helper functions that scan memory for characters. When SIMD is available they process 32 or 16
+// characters at a time and fall back to processing one character at a time for the remaining 
+// characters at the end. SSE2 is selected at compile time. The parts that use AVX2 are separate
+// functions compiled for AVX2 and they are only called if the CPU running the program supports
+// AVX2, which is checked once and then cached. When the compiler already targets AVX2 there is no
+// check and they are always called.
+// ------------------------------------------------------------------------------------------------
 
-/// Returns if a character is an uppercase ASCII character.
-/// @param[in] character A character to check.
-/// @return If the character is an uppercase ASCII character.
-[[nodiscard]]
-inline bool is_upper(const char character) noexcept
-{
-	int value = static_cast<int>(static_cast<unsigned char>(character));
-	if ((value >= 65) && (value <= 90))
-	{
-		return true;
-	}
-	return false;
-}
+#if defined(MTL_SIMD_AVX2)
 
-/// Returns if all characters in an std::string are uppercase ASCII characters.
-/// @param[in] value An std::string to check.
-/// @return If all the characters are uppercase ASCII characters.
+// Returns if the CPU running the program supports AVX2 and the operating system saves the AVX
+// registers. The CPU is checked only the first time, after that the result is cached.
 [[nodiscard]]
-inline bool is_upper(const std::string& value) noexcept
+inline bool has_avx2() noexcept
 {
-	for (const char character : value)
+#if defined(__AVX2__)
+	return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+	static const bool supported = []()
 	{
-		if (is_upper(character) == false)
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7) { return false; }
+
+		// the CPU supports AVX and XSAVE, and the operating system saves the AVX registers, the
+		// registers are checked with _xgetbv only after we know XSAVE is enabled
+		__cpuid(info, 1);
+		const bool has_osxsave = ((info[2] & (1 << 27)) != 0);
+		const bool has_avx = ((info[2] & (1 << 28)) != 0);
+		if ((has_osxsave == false) || (has_avx == false) || ((_xgetbv(0) & 6) != 6))
 		{
 			return false;
 		}
-	}
-	return true;
+
+		__cpuidex(info, 7, 0);
+		return ((info[1] & (1 << 5)) != 0);
+	}();
+	return supported;
+#else
+	static const bool supported = []()
+	{
+		__builtin_cpu_init();
+		return (__builtin_cpu_supports("avx2") != 0);
+	}();
+	return supported;
+#endif // __AVX2__ end
 }
 
+#endif // MTL_SIMD_AVX2 end
 
-/// Returns if a character is a lowercase ASCII character.
-/// @param[in] character A character to check.
-/// @return If the character is a lowercase ASCII character.
+// Returns the number of trailing zero bits for a value. The value must not be 0.
 [[nodiscard]]
-inline bool is_lower(const char character) noexcept
+inline unsigned int trailing_zeros(const uint32_t value) noexcept
 {
-	int value = static_cast<int>(static_cast<unsigned char>(character));
-	if ((value >= 97) && (value <= 122))
-	{
-		return true;
-	}
-	return false;
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index = 0;
+	_BitScanForward(&index, static_cast<unsigned long>(value));
+	return static_cast<unsigned int>(index);
+#else
+	return static_cast<unsigned int>(__builtin_ctz(value));
+#endif // _MSC_VER end
 }
 
-/// Returns if all characters in an std::string are lowercase ASCII characters.
-/// @param[in] value An std::string to check.
-/// @return If all the characters are lowercase ASCII characters.
+// Returns the position of the highest set bit for a value. The value must not be 0.
 [[nodiscard]]
-inline bool is_lower(const std::string& value) noexcept
+inline unsigned int highest_bit(const uint32_t value) noexcept
 {
-	for (const char character : value)
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index = 0;
+	_BitScanReverse(&index, static_cast<unsigned long>(value));
+	return static_cast<unsigned int>(index);
+#else
+	return static_cast<unsigned int>(31 - __builtin_clz(value));
+#endif // _MSC_VER end
+}
+
+#if defined(MTL_SIMD_AVX2)
+
+// The AVX2 part of mtl::detail::for_each_char. Processes 32 characters at a time and returns the
+// number of characters it has processed.
+template<typename Function>
+[[nodiscard]]
+MTL_TARGET_AVX2
+inline size_t for_each_char_avx2(const char* data, const size_t size, const char character,
+								 Function& function)
+{
+	size_t i = 0;
+	const __m256i pattern_32 = _mm256_set1_epi8(character);
+	while ((i + 32) <= size)
 	{
-		if (is_lower(character) == false)
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		// each bit of the mask is set if the character at that position matches
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block,
+																				  pattern_32)));
+		while (mask != 0)
 		{
-			return false;
+			function(i + trailing_zeros(mask));
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
 		}
+		i += 32;
 	}
-	return true;
+	return i;
 }
 
+#endif // MTL_SIMD_AVX2 end
 
-// ================================================================================================
-// TO_UPPER - Converts a lowercase ASCII character to uppercase.
-// TO_UPPER - Converts all lowercase ASCII characters of an std::string to uppercase.
-// TO_LOWER - Converts an uppercase ASCII character to lowercase.
-// TO_LOWER - Converts all uppercase ASCII characters of an std::string to lowercase.
-// ================================================================================================
-
-/// Converts a lowercase ASCII character to uppercase.
-/// @param[in, out] character A character to convert to uppercase.
-inline void to_upper(char& character) noexcept
+// Calls the function with the position of each occurrence of the character in the given memory,
+// from first to last, in a single pass.
+template<typename Function>
+inline void for_each_char(const char* data, const size_t size, const char character,
+						  Function&& function)
 {
-	if (is_lower(character))
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2()) { i = for_each_char_avx2(data, size, character, function); }
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	const __m128i pattern_16 = _mm_set1_epi8(character);
+	while ((i + 16) <= size)
 	{
-		int value = static_cast<int>(static_cast<unsigned char>(character));
-		// it so happens that in an ASCII table the uppercase characters are 32 positions before 
-		// lowercase characters
-		value = value - 32;
-		character = static_cast<char>(value);
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		// each bit of the mask is set if the character at that position matches
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern_16)));
+		while (mask != 0)
+		{
+			function(i + trailing_zeros(mask));
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
+		}
+		i += 16;
 	}
-}
+#endif // MTL_SIMD_SSE2 end
 
-/// Converts all lowercase ASCII characters in an std::string to uppercase.
-/// @param[in, out] value An std::string to convert all it's characters to uppercase.
-inline void to_upper(std::string& value) noexcept
-{
-	for (char& character : value) 
-	{ 
-		to_upper(character); 
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
+	{
+		if (data[i] == character)
+		{
+			function(i);
+		}
 	}
 }
 
-/// Converts an uppercase ASCII character to lowercase.
-/// @param[in, out] character A character to convert to lowercase.
-inline void to_lower(char& character) noexcept
+#if defined(MTL_SIMD_AVX2)
+
+// The AVX2 part of mtl::detail::find_char. Processes 32 characters at a time and returns the
+// position of the character or std::string_view::npos if it isn't found. When it isn't found
+// checked is set to the number of characters that were checked.
+[[nodiscard]]
+MTL_TARGET_AVX2
+inline size_t find_char_avx2(const char* data, const size_t size, const char character,
+							 size_t& checked) noexcept
 {
-	if (is_upper(character))
+	size_t i = 0;
+	const __m256i pattern_32 = _mm256_set1_epi8(character);
+	while ((i + 32) <= size)
 	{
-		int value = static_cast<int>(static_cast<unsigned char>(character));
-		// it so happens that in an ASCII table the lowercase characters are 32 positions after 
-		// uppercase characters
-		value = value + 32;
-		character = static_cast<char>(value);
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		// each bit of the mask is set if the character at that position matches
+		const __m256i matches = _mm256_cmpeq_epi8(block, pattern_32);
+		const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+		if (mask != 0) { return i + trailing_zeros(mask); }
+		i += 32;
 	}
+	checked = i;
+	return std::string_view::npos;
 }
 
-/// Converts all uppercase ASCII characters of an std::string to lowercase characters.
-/// @param[in, out] value An std::string to convert all it's characters to lowercase.
-inline void to_lower(std::string& value) noexcept
+#endif // MTL_SIMD_AVX2 end
+
+// Returns the position of the first occurrence of the character in the given memory or
+// std::string_view::npos if the character isn't found.
+[[nodiscard]]
+inline size_t find_char(const char* data, const size_t size, const char character) noexcept
 {
-	for (char& character : value) 
-	{ 
-		to_lower(character); 
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2())
+	{
+		const size_t found = find_char_avx2(data, size, character, i);
+		if (found != std::string_view::npos) { return found; }
+	}
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	const __m128i pattern_16 = _mm_set1_epi8(character);
+	while ((i + 16) <= size)
+	{
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		// each bit of the mask is set if the character at that position matches
+		const __m128i matches = _mm_cmpeq_epi8(block, pattern_16);
+		const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+		if (mask != 0) { return i + trailing_zeros(mask); }
+		i += 16;
+	}
+#endif // MTL_SIMD_SSE2 end
+
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
+	{
+		if (data[i] == character)
+		{
+			return i;
+		}
 	}
+	return std::string_view::npos;
 }
 
+// Returns the number of occurrences of the character in the given memory.
+[[nodiscard]]
+inline size_t count_char(const char* data, const size_t size, const char character) noexcept
+{
+	size_t count = 0;
+	size_t i = 0;
 
+#if defined(MTL_SIMD_SSE2)
+	const __m128i pattern = _mm_set1_epi8(character);
+	const __m128i zero = _mm_setzero_si128();
+	while ((i + 16) <= size)
+	{
+		// matching characters are 0xFF which is -1, so subtracting the comparison result adds
+		// one to each byte counter, the byte counters overflow after 255 blocks
+		__m128i counters = _mm_setzero_si128();
+		size_t blocks = 0;
+		while ((blocks < 255) && ((i + 16) <= size))
+		{
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(block, pattern));
+			i += 16;
+			++blocks;
+		}
+		// sum the byte counters to two 64 bit numbers, each one is small enough to fit 16 bits
+		const __m128i sums = _mm_sad_epu8(counters, zero);
+		count += static_cast<size_t>(_mm_cvtsi128_si32(sums));
+		count += static_cast<size_t>(_mm_extract_epi16(sums, 4));
+	}
+#endif // MTL_SIMD_SSE2 end
 
-// ================================================================================================
-// IS_ASCII - Returns if char is an ASCII character.
-// IS_ASCII - Returns if all characters in an std::string are ASCII characters.
-// ================================================================================================
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
+	{
+		if (data[i] == character)
+		{
+			++count;
+		}
+	}
+	return count;
+}
 
-/// Returns if the character is an ASCII character.
-/// @param[in] character A character to check.
-/// @return If the character is an ASCII character.
+// Returns if the character is within one of the ranges of characters. The ranges are given as
+// pairs of the lowest and the highest character of each range.
+template<char Low, char High, char... Ranges>
 [[nodiscard]]
-inline bool is_ascii(const char character) noexcept
+inline bool in_ranges(const char character) noexcept
 {
-	int value = static_cast<int>(static_cast<unsigned char>(character));
-	// is the value within the ASCII range of characters
-	if ((value >= 0) && (value <= 127)) // GCOVR_EXCL_LINE
+	const auto value = static_cast<unsigned char>(character);
+	if ((value >= static_cast<unsigned char>(Low)) && (value <= static_cast<unsigned char>(High)))
 	{
 		return true;
 	}
+	if constexpr (sizeof...(Ranges) > 0)
+	{
+		return in_ranges<Ranges...>(character);
+	}
 	return false;
 }
 
-/// Returns if all the characters in an std::string are ASCII characters.
-/// @param[in] value An std::string to check.
-/// @return If all characters of the std::string are ASCII characters.
+#if defined(MTL_SIMD_SSE2)
+
+// Returns a mask where each character of the block that is within one of the ranges of characters
+// has all its bits set. SSE2 only has signed comparisons so the characters are moved so the start
+// of each range becomes the lowest signed value and then a single comparison is enough.
+template<char Low, char High, char... Ranges>
 [[nodiscard]]
-inline bool is_ascii(const std::string& value) noexcept
+inline __m128i in_ranges_16(const __m128i block) noexcept
 {
-	for (const char character : value)
+	constexpr int low_value = static_cast<unsigned char>(Low);
+	constexpr int range_size = static_cast<unsigned char>(High) - low_value + 1;
+	const __m128i moved = _mm_add_epi8(block, _mm_set1_epi8(static_cast<char>(128 - low_value)));
+	const __m128i limit = _mm_set1_epi8(static_cast<char>(range_size - 128));
+	const __m128i matches = _mm_cmplt_epi8(moved, limit);
+	if constexpr (sizeof...(Ranges) > 0)
 	{
-		// check if there are any non-ASCII characters
-		if (is_ascii(character) == false)
-		{
-			return false;
-		}
+		return _mm_or_si128(matches, in_ranges_16<Ranges...>(block));
 	}
-	return true;
+	return matches;
 }
 
+#endif // MTL_SIMD_SSE2 end
 
+#if defined(MTL_SIMD_AVX2)
 
-// ================================================================================================
-// IS_ALPHABETIC - Returns if a character / all characters in std::string are ASCII alphabetic 
-//                 characters or not.
-// IS_NUMERIC    - Returns if a character / all characters in std::string are ASCII numbers or not.
-// IS_ALPHANUM   - Returns if a character / all characters in std::string are ASCII alphanumeric 
-//                 characters or not.
-// ================================================================================================
-
-/// Returns if a character is an ASCII alphabetic character.
-/// @param[in] character A character to check.
-/// @return If the character is an ASCII alphabetic character.
+// The same as mtl::detail::in_ranges_16 for 32 characters.
+template<char Low, char High, char... Ranges>
 [[nodiscard]]
-inline bool is_alphabetic(const char character) noexcept
+MTL_TARGET_AVX2
+inline __m256i in_ranges_32(const __m256i block) noexcept
 {
-	int value = static_cast<int>(static_cast<unsigned char>(character));
-	if (((value >= 65) && (value <= 90)) || ((value >= 97) && (value <= 122)))
+	constexpr int low_value = static_cast<unsigned char>(Low);
+	constexpr int range_size = static_cast<unsigned char>(High) - low_value + 1;
+	const __m256i moved = _mm256_add_epi8(block,
+										  _mm256_set1_epi8(static_cast<char>(128 - low_value)));
+	const __m256i limit = _mm256_set1_epi8(static_cast<char>(range_size - 128));
+	const __m256i matches = _mm256_cmpgt_epi8(limit, moved);
+	if constexpr (sizeof...(Ranges) > 0)
 	{
-		return true;
+		return _mm256_or_si256(matches, in_ranges_32<Ranges...>(block));
 	}
-	return false;
+	return matches;
 }
 
-/// Returns if all characters in an std::string are ASCII alphabetic characters.
-/// @param[in] value An std::string to check.
-/// @return If all the characters of an std::string are ASCII alphabetic characters.
+// The AVX2 part of mtl::detail::all_in_ranges. Checks 32 characters at a time and returns the
+// number of characters that were checked and are all within the ranges. It stops at the first 32
+// characters that aren't all within the ranges, so the caller checks them again and finds out.
+template<char... Ranges>
 [[nodiscard]]
-inline bool is_alphabetic(const std::string& value) noexcept
+MTL_TARGET_AVX2
+inline size_t all_in_ranges_avx2(const char* data, const size_t size) noexcept
 {
-	for (const char character : value)
+	size_t i = 0;
+	while ((i + 32) <= size)
 	{
-		// if the character isn't alphanumeric
-		if (is_alphabetic(character) == false)
-		{
-			return false;
-		}
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		// each bit of the mask is set if the character at that position is in one of the ranges
+		const __m256i matches = in_ranges_32<Ranges...>(block);
+		if (static_cast<uint32_t>(_mm256_movemask_epi8(matches)) != 0xFFFFFFFFu) { break; }
+		i += 32;
 	}
-	return true;
+	return i;
 }
 
-/// Returns if a character is an ASCII number.
-/// @param[in] character A character to check.
-/// @return If the character is an ASCII number.
+#endif // MTL_SIMD_AVX2 end
+
+// Returns if all characters in the given memory are within one of the ranges of characters. The
+// ranges are given as pairs of the lowest and the highest character of each range.
+template<char... Ranges>
 [[nodiscard]]
-inline bool is_numeric(const char character) noexcept
+inline bool all_in_ranges(const char* data, const size_t size) noexcept
 {
-	int value = static_cast<int>(static_cast<unsigned char>(character));
-	if ((value >= 48) && (value <= 57))
+	static_assert(((sizeof...(Ranges) % 2) == 0), "The ranges should be pairs of characters.");
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2()) { i = all_in_ranges_avx2<Ranges...>(data, size); }
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	while ((i + 16) <= size)
 	{
-		return true;
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		// each bit of the mask is set if the character at that position is in one of the ranges
+		if (_mm_movemask_epi8(in_ranges_16<Ranges...>(block)) != 0xFFFF) { return false; }
+		i += 16;
 	}
-	return false;
-}
+#endif // MTL_SIMD_SSE2 end
 
-/// Returns if all characters in an std::string are ASCII numbers.
-/// @param[in] value An std::string to check.
-/// @return If all the characters of an std::string are ASCII numeric characters.
-[[nodiscard]]
-inline bool is_numeric(const std::string& value) noexcept
-{
-	for (const char character : value)
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
 	{
-		// if the character isn't alphanumeric
-		if (is_numeric(character) == false)
+		if (in_ranges<Ranges...>(data[i]) == false)
 		{
 			return false;
 		}
@@ -272,29 +453,52 @@ inline bool is_numeric(const std::string& value) noexcept
 	return true;
 }
 
-/// Returns if a character is an ASCII alphabetic or numeric character.
-/// @param[in] character A character to check.
-/// @return If the character is an ASCII alphanumeric character.
+#if defined(MTL_SIMD_AVX2)
+
+// The AVX2 part of mtl::detail::all_ascii. Checks 32 characters at a time and returns the number
+// of characters that were checked and are all ASCII. It stops at the first 32 characters that
+// aren't all ASCII, so the caller checks them again and finds out.
 [[nodiscard]]
-inline bool is_alphanum(const char character) noexcept
+MTL_TARGET_AVX2
+inline size_t all_ascii_avx2(const char* data, const size_t size) noexcept
 {
-	if ((is_alphabetic(character))	|| (is_numeric(character)))
+	size_t i = 0;
+	while ((i + 32) <= size)
 	{
-		return true;
+		// the highest bit of each character is set only for characters that aren't ASCII
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		if (_mm256_movemask_epi8(block) != 0) { break; }
+		i += 32;
 	}
-	return false;
+	return i;
 }
 
-/// Returns if all characters in an std::string are ASCII alphabetic or numeric characters.
-/// @param[in] value An std::string to check.
-/// @return If all the characters of an std::string are ASCII alphanumeric characters.
+#endif // MTL_SIMD_AVX2 end
+
+// Returns if all characters in the given memory are ASCII characters.
 [[nodiscard]]
-inline bool is_alphanum(const std::string& value) noexcept
+inline bool all_ascii(const char* data, const size_t size) noexcept
 {
-	for (const char character : value)
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2()) { i = all_ascii_avx2(data, size); }
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	while ((i + 16) <= size)
+	{
+		// the highest bit of each character is set only for characters that aren't ASCII
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		if (_mm_movemask_epi8(block) != 0) { return false; }
+		i += 16;
+	}
+#endif // MTL_SIMD_SSE2 end
+
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
 	{
-		// if the character isn't alphanumeric
-		if (is_alphanum(character) == false)
+		if ((static_cast<unsigned char>(data[i]) & 0x80) != 0)
 		{
 			return false;
 		}
@@ -302,475 +506,1989 @@ inline bool is_alphanum(const std::string& value) noexcept
 	return true;
 }
 
+#if defined(MTL_SIMD_AVX2)
 
-// ================================================================================================
-// CONTAINS - Returns if a substring exists within a string. 
-// ================================================================================================
-
-
-/// Returns if a substring is found inside the input string or not.
-/// @param[in] value An std::string to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
+// The AVX2 part of mtl::detail::flip_case_in_range. Processes 32 characters at a time and returns
+// the number of characters it has processed.
+template<char Low, char High>
 [[nodiscard]]
-inline bool contains(const std::string& value, const std::string& match)
+MTL_TARGET_AVX2
+inline size_t flip_case_in_range_avx2(char* data, const size_t size) noexcept
 {
-	if (value.find(match) != std::string::npos) 
-	{ 
-		return true; 
+	size_t i = 0;
+	const __m256i case_bit_32 = _mm256_set1_epi8(32);
+	while ((i + 32) <= size)
+	{
+		auto* address = reinterpret_cast<__m256i*>(data + i);
+		const __m256i block = _mm256_loadu_si256(address);
+		const __m256i flip = _mm256_and_si256(in_ranges_32<Low, High>(block), case_bit_32);
+		_mm256_storeu_si256(address, _mm256_xor_si256(block, flip));
+		i += 32;
 	}
-	return false;
+	return i;
 }
 
-/// Returns if a substring is found inside the input string or not.
-/// @param[in] value An std::string to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
-[[nodiscard]]
-inline bool contains(const std::string& value, const char* match)
+#endif // MTL_SIMD_AVX2 end
+
+// Flips the case of all characters in the given memory that are within the range of characters
+// from Low to High. In ASCII uppercase and lowercase characters only differ by the bit with the
+// value 32, so it is used with the range of lowercase characters to convert to uppercase and with
+// the range of uppercase characters to convert to lowercase.
+template<char Low, char High>
+inline void flip_case_in_range(char* data, const size_t size) noexcept
 {
-	// handle the case when const char* is nullptr
-	if(match == nullptr)
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2()) { i = flip_case_in_range_avx2<Low, High>(data, size); }
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	const __m128i case_bit_16 = _mm_set1_epi8(32);
+	while ((i + 16) <= size)
 	{
-		return false;
+		auto* address = reinterpret_cast<__m128i*>(data + i);
+		const __m128i block = _mm_loadu_si128(address);
+		const __m128i flip = _mm_and_si128(in_ranges_16<Low, High>(block), case_bit_16);
+		_mm_storeu_si128(address, _mm_xor_si128(block, flip));
+		i += 16;
 	}
+#endif // MTL_SIMD_SSE2 end
 
-	// search for match
-	size_t pos = value.find(match);
-	if (pos != std::string::npos) 
-	{ 
-		return true; 
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
+	{
+		if (in_ranges<Low, High>(data[i]))
+		{
+			data[i] = static_cast<char>(data[i] ^ 32);
+		}
 	}
-	return false;
 }
 
-/// Returns if a char is found inside the input string or not.
-/// @param[in] value An std::string to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
+#if defined(MTL_SIMD_AVX2)
+
+// The AVX2 part of mtl::detail::find_substring. Checks 32 positions at a time and returns the
+// position of the needle or std::string_view::npos if it isn't found. When it isn't found checked
+// is set to the number of positions that were checked. The needle must be at least 2 characters
+// long and not longer than the memory.
 [[nodiscard]]
-inline bool contains(const std::string& value, const char match)
+MTL_TARGET_AVX2
+inline size_t find_substring_avx2(const char* data, const size_t size, const char* needle,
+								  const size_t needle_size, const size_t filter_offset,
+								  size_t& checked) noexcept
 {
-	if (value.find(match) != std::string::npos) 
-	{ 
-		return true; 
+	// the last position where a match can start
+	const size_t last_start = size - needle_size;
+	size_t i = 0;
+	const __m256i first_32 = _mm256_set1_epi8(needle[0]);
+	const __m256i filter_32 = _mm256_set1_epi8(needle[filter_offset]);
+	// the size check is redundant but stops GCC from warning about out of bounds loads for inputs
+	// shorter than a block
+	while ((size >= 32) && ((i + 32) <= (last_start + 1)))
+	{
+		// skip the blocks where no match can start in a loop of their own, without it the call to
+		// std::memcmp makes the compiler keep the position in memory instead of a register
+		uint32_t mask = 0;
+		while ((i + 32) <= (last_start + 1))
+		{
+			const auto* first_block = reinterpret_cast<const __m256i*>(data + i);
+			const auto* filter_block = reinterpret_cast<const __m256i*>(data + i + filter_offset);
+			const __m256i first_matches = _mm256_cmpeq_epi8(_mm256_loadu_si256(first_block),
+															first_32);
+			const __m256i filter_matches = _mm256_cmpeq_epi8(_mm256_loadu_si256(filter_block),
+															 filter_32);
+			// each bit of the mask is set if a match can start at that position
+			mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first_matches,
+																			   filter_matches)));
+			if (mask != 0) { break; }
+			i += 32;
+		}
+		// the end was reached without finding a block where a match can start
+		if (mask == 0) { break; }
+
+		while (mask != 0)
+		{
+			const size_t position = i + trailing_zeros(mask);
+			if (std::memcmp(data + position + 1, needle + 1, needle_size - 1) == 0)
+			{
+				return position;
+			}
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
+		}
+		i += 32;
 	}
-	return false;
+	checked = i;
+	return std::string_view::npos;
 }
 
+#endif // MTL_SIMD_AVX2 end
 
-
-/// Returns if a substring is found inside the input string or not.
-/// @param[in] value A const char* to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
+// Returns the position of the first occurrence of the needle in the given memory or
+// std::string_view::npos if the needle isn't found. When SIMD is available it compares the first
+// character of the needle and a second filter character at the given offset of the needle for 32
+// or 16 positions at a time and only compares the whole needle for the positions where both of
+// them match. This avoids the slowdown of a simple search with long needles and repetitive input.
 [[nodiscard]]
-inline bool contains(const char* value, const std::string& match)
+inline size_t find_substring(const char* data, const size_t size, const char* needle,
+							 const size_t needle_size, const size_t filter_offset) noexcept
 {
-	// handle the case when const char* is nullptr
-	if(value == nullptr)
+	if (needle_size == 0) { return 0; }
+	if (needle_size > size) { return std::string_view::npos; }
+	if (needle_size == 1) { return find_char(data, size, needle[0]); }
+
+#ifndef MTL_SIMD_SSE2
+	// without SIMD the search of the standard library is faster than the filter
+	static_cast<void>(filter_offset);
+	return std::string_view(data, size).find(std::string_view(needle, needle_size));
+#else
+	// the last position where a match can start
+	const size_t last_start = size - needle_size;
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2())
 	{
-		return false;
+		const size_t found = find_substring_avx2(data, size, needle, needle_size, filter_offset,
+												 i);
+		if (found != std::string_view::npos) { return found; }
 	}
+#endif // MTL_SIMD_AVX2 end
 
-	// search for match
-	const auto pos = std::strstr(value, match.c_str());
-	if(pos != nullptr)
+	const __m128i first_16 = _mm_set1_epi8(needle[0]);
+	const __m128i filter_16 = _mm_set1_epi8(needle[filter_offset]);
+	while ((i + 16) <= (last_start + 1))
 	{
-		return true;
-	}
-	return false;
+		const auto* first_block = reinterpret_cast<const __m128i*>(data + i);
+		const auto* filter_block = reinterpret_cast<const __m128i*>(data + i + filter_offset);
+		const __m128i first_matches = _mm_cmpeq_epi8(_mm_loadu_si128(first_block), first_16);
+		const __m128i filter_matches = _mm_cmpeq_epi8(_mm_loadu_si128(filter_block), filter_16);
+		// each bit of the mask is set if a match can start at that position
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first_matches,
+																		  filter_matches)));
+		while (mask != 0)
+		{
+			const size_t position = i + trailing_zeros(mask);
+			if (std::memcmp(data + position + 1, needle + 1, needle_size - 1) == 0)
+			{
+				return position;
+			}
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
+		}
+		i += 16;
+	}
+
+	// process the remaining positions one at a time
+	for (; i <= last_start; ++i)
+	{
+		if ((data[i] == needle[0]) && (data[i + filter_offset] == needle[filter_offset]) &&
+			(std::memcmp(data + i + 1, needle + 1, needle_size - 1) == 0))
+		{
+			return i;
+		}
+	}
+	return std::string_view::npos;
+#endif // MTL_SIMD_SSE2 end
 }
 
-/// Returns if a substring is found inside the input string or not.
-/// @param[in] value A const char* to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
+// Returns the position of the first occurrence of the match in the input starting from the given
+// position or std::string_view::npos if the match isn't found. It behaves exactly like the find
+// member function of std::string and std::string_view.
 [[nodiscard]]
-inline bool contains(const char* value, const char* match)
+inline size_t find_substring(std::string_view value, std::string_view match,
+							 const size_t position = 0) noexcept
 {
-	// handle the case when const char* is nullptr
-	if((value == nullptr) || (match == nullptr))
+	if (position > value.size()) { return std::string_view::npos; }
+
+	// the last character of the needle is used as the second filter character
+	size_t filter_offset = 0;
+	if (match.empty() == false) { filter_offset = match.size() - 1; }
+
+	const size_t found = find_substring(value.data() + position, value.size() - position,
+										match.data(), match.size(), filter_offset);
+	if (found == std::string_view::npos) { return found; }
+	return position + found;
+}
+
+// Converts an uppercase ASCII character to lowercase and leaves all other characters unchanged.
+[[nodiscard]]
+inline char fold_case(const char character) noexcept
+{
+	if (in_ranges<'A', 'Z'>(character))
 	{
-		return false;
+		return static_cast<char>(character | 32);
 	}
+	return character;
+}
 
-	// search for match
-	const auto pos = std::strstr(value, match);
-	if(pos != nullptr)
+#if defined(MTL_SIMD_SSE2)
+
+// Converts all uppercase ASCII characters of the block to lowercase.
+[[nodiscard]]
+inline __m128i fold_case_16(const __m128i block) noexcept
+{
+	const __m128i case_bit = _mm_and_si128(in_ranges_16<'A', 'Z'>(block), _mm_set1_epi8(32));
+	return _mm_or_si128(block, case_bit);
+}
+
+#endif // MTL_SIMD_SSE2 end
+
+#if defined(MTL_SIMD_AVX2)
+
+// Converts all uppercase ASCII characters of the block to lowercase.
+[[nodiscard]]
+MTL_TARGET_AVX2
+inline __m256i fold_case_32(const __m256i block) noexcept
+{
+	const __m256i case_bit = _mm256_and_si256(in_ranges_32<'A', 'Z'>(block),
+											  _mm256_set1_epi8(32));
+	return _mm256_or_si256(block, case_bit);
+}
+
+// The AVX2 part of mtl::detail::equal_ignore_case. Compares 32 characters at a time and returns
+// the number of characters that were compared and are the same. It stops at the first 32
+// characters that aren't all the same, so the caller compares them again and finds out.
+[[nodiscard]]
+MTL_TARGET_AVX2
+inline size_t equal_ignore_case_avx2(const char* lhs, const char* rhs, const size_t size) noexcept
+{
+	size_t i = 0;
+	while ((i + 32) <= size)
 	{
-		return true;
+		const __m256i lhs_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+		const __m256i rhs_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+		const __m256i same = _mm256_cmpeq_epi8(fold_case_32(lhs_block), fold_case_32(rhs_block));
+		if (static_cast<uint32_t>(_mm256_movemask_epi8(same)) != 0xFFFFFFFFu) { break; }
+		i += 32;
 	}
-	return false;
+	return i;
 }
 
+#endif // MTL_SIMD_AVX2 end
 
-/// Returns if a char is found inside the input string or not.
-/// @param[in] value An std::string to check for a match.
-/// @param[in] match A match to search in the input.
-/// @return If the match was found.
+// Returns if the characters in the two given memory locations are the same when ASCII case is
+// ignored.
 [[nodiscard]]
-inline bool contains(const char* value, const char match)
+inline bool equal_ignore_case(const char* lhs, const char* rhs, const size_t size) noexcept
 {
-	// handle the case when const char* is nullptr
-	if(value == nullptr)
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2()) { i = equal_ignore_case_avx2(lhs, rhs, size); }
+#endif // MTL_SIMD_AVX2 end
+
+#if defined(MTL_SIMD_SSE2)
+	while ((i + 16) <= size)
 	{
-		return false;
+		const __m128i lhs_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+		const __m128i rhs_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+		const __m128i same = _mm_cmpeq_epi8(fold_case_16(lhs_block), fold_case_16(rhs_block));
+		if (_mm_movemask_epi8(same) != 0xFFFF) { return false; }
+		i += 16;
 	}
+#endif // MTL_SIMD_SSE2 end
 
-	if(std::strchr(value, static_cast<int>(match)) != nullptr)
+	// process the remaining characters one at a time
+	for (; i < size; ++i)
 	{
-		return true;
-	} 	
-	return false;
+		if (fold_case(lhs[i]) != fold_case(rhs[i]))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
+#if defined(MTL_SIMD_AVX2)
 
+// The AVX2 part of mtl::detail::find_substring_ignore_case. Checks 32 positions at a time and
+// returns the position of the needle or std::string_view::npos if it isn't found. When it isn't
+// found checked is set to the number of positions that were checked. The first and last
+// characters of the needle must already be converted to lowercase. The needle must not be empty or
+// longer than the memory.
+[[nodiscard]]
+MTL_TARGET_AVX2
+inline size_t find_substring_ignore_case_avx2(const char* data, const size_t size,
+											  const char* needle, const size_t needle_size,
+											  const char first, const char last,
+											  size_t& checked) noexcept
+{
+	// the last position where a match can start
+	const size_t last_start = size - needle_size;
+	const size_t last_offset = needle_size - 1;
+	size_t i = 0;
+	const __m256i first_32 = _mm256_set1_epi8(first);
+	const __m256i last_32 = _mm256_set1_epi8(last);
+	while ((i + 32) <= (last_start + 1))
+	{
+		// skip the blocks where no match can start in a loop of their own, without it the call to
+		// compare the whole needle makes the compiler keep the position in memory
+		uint32_t mask = 0;
+		while ((i + 32) <= (last_start + 1))
+		{
+			const auto* first_block = reinterpret_cast<const __m256i*>(data + i);
+			const auto* last_block = reinterpret_cast<const __m256i*>(data + i + last_offset);
+			const __m256i first_matches = _mm256_cmpeq_epi8(
+										  fold_case_32(_mm256_loadu_si256(first_block)), first_32);
+			const __m256i last_matches = _mm256_cmpeq_epi8(
+										 fold_case_32(_mm256_loadu_si256(last_block)), last_32);
+			// each bit of the mask is set if a match can start at that position
+			mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first_matches,
+																			   last_matches)));
+			if (mask != 0) { break; }
+			i += 32;
+		}
+		// the end was reached without finding a block where a match can start
+		if (mask == 0) { break; }
 
+		while (mask != 0)
+		{
+			const size_t position = i + trailing_zeros(mask);
+			if (equal_ignore_case(data + position, needle, needle_size))
+			{
+				return position;
+			}
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
+		}
+		i += 32;
+	}
+	checked = i;
+	return std::string_view::npos;
+}
 
-// ===============================================================================================
-// STRIP_FRONT  - Strips all matching characters from the front.
-// STRIP_BACK   - Strips all matching characters from the back.
-// STRIP        - Strips all matching characters from the front and back.
-// ===============================================================================================
+#endif // MTL_SIMD_AVX2 end
 
-/// Strips all matching characters from the front side of the string. Performs no heap 
-/// allocation.
-/// @param[in, out] value An std::string to strip from the front.
-/// @param[in] match An optional character to remove if it matches.
-inline void strip_front(std::string& value, const char match = ' ')
+// Returns the position of the first occurrence of the needle in the given memory when ASCII case
+// is ignored or std::string_view::npos if the needle isn't found. It works the same way as
+// mtl::detail::find_substring using the first and the last character of the needle as filters,
+// but the characters of the input are converted to lowercase before they are compared.
+[[nodiscard]]
+inline size_t find_substring_ignore_case(const char* data, const size_t size, const char* needle,
+										 const size_t needle_size) noexcept
 {
-	// count how many characters match
-	size_t count = 0;
-	for (const char character : value)
+	if (needle_size == 0) { return 0; }
+	if (needle_size > size) { return std::string_view::npos; }
+
+	// the last position where a match can start
+	const size_t last_start = size - needle_size;
+	const size_t last_offset = needle_size - 1;
+	const char first = fold_case(needle[0]);
+	const char last = fold_case(needle[last_offset]);
+	size_t i = 0;
+
+#if defined(MTL_SIMD_AVX2)
+	if ((size >= 32) && has_avx2())
 	{
-		if (character != match) { break; }
-		++count;
+		const size_t found = find_substring_ignore_case_avx2(data, size, needle, needle_size,
+															 first, last, i);
+		if (found != std::string_view::npos) { return found; }
 	}
+#endif // MTL_SIMD_AVX2 end
 
-	// if there are no matches leave
-	if(count == 0)
+#if defined(MTL_SIMD_SSE2)
+	const __m128i first_16 = _mm_set1_epi8(first);
+	const __m128i last_16 = _mm_set1_epi8(last);
+	while ((i + 16) <= (last_start + 1))
 	{
-		return;
+		const auto* first_block = reinterpret_cast<const __m128i*>(data + i);
+		const auto* last_block = reinterpret_cast<const __m128i*>(data + i + last_offset);
+		const __m128i first_matches = _mm_cmpeq_epi8(fold_case_16(_mm_loadu_si128(first_block)),
+													 first_16);
+		const __m128i last_matches = _mm_cmpeq_epi8(fold_case_16(_mm_loadu_si128(last_block)),
+													last_16);
+		// each bit of the mask is set if a match can start at that position
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first_matches,
+																		  last_matches)));
+		while (mask != 0)
+		{
+			const size_t position = i + trailing_zeros(mask);
+			if (equal_ignore_case(data + position, needle, needle_size))
+			{
+				return position;
+			}
+			// clear the lowest set bit
+			mask = mask & (mask - 1);
+		}
+		i += 16;
 	}
+#endif // MTL_SIMD_SSE2 end
 
-	// if the number of characters matching are less that the length of the string
-	if (count < value.size())
+	// process the remaining positions one at a time
+	for (; i <= last_start; ++i)
 	{
-		// remove unwanted characters from the start
-		value.erase(0, count);
+		if ((fold_case(data[i]) == first) && (fold_case(data[i + last_offset]) == last) &&
+			(equal_ignore_case(data + i, needle, needle_size)))
+		{
+			return i;
+		}
 	}
-	// else if the number of characters matching are equal to the length of the string
-	else
+	return std::string_view::npos;
+}
+
+// ------------------------------------------------------------------------------------------------
+// A set of characters stored as a 256-bit table with one bit for each possible character, so
+// checking if a character is part of the set takes a single lookup no matter the size of the set.
+// ------------------------------------------------------------------------------------------------
+class char_set
+{
+	// one bit for each of the 256 possible values of a char
+	std::array<uint64_t, 4> bits {};
+
+public:
+
+	char_set() = default;
+
+	// Creates a set that contains all the given characters.
+	explicit char_set(std::string_view characters) noexcept
 	{
-		value.resize(0);
+		for (const char character : characters)
+		{
+			insert(character);
+		}
 	}
-}
 
+	// Adds a character to the set.
+	void insert(const char character) noexcept
+	{
+		const auto value = static_cast<unsigned char>(character);
+		bits[value >> 6] = bits[value >> 6] | (uint64_t(1) << (value & 63));
+	}
 
-/// Strips all matching characters from the back side of the string. Performs no heap 
-/// allocation.
-/// @param[in, out] value An std::string to strip from the back.
-/// @param[in] match An optional character to remove if it matches.
-inline void strip_back(std::string& value, const char match = ' ')
-{
-	size_t count = 0;
-	// count how many character match from the end using reverse iterator
-	for (auto it = value.rbegin(); it != value.rend(); ++it)
+	// Returns if the character is part of the set.
+	[[nodiscard]]
+	bool contains(const char character) const noexcept
 	{
-		if (*it != match) { break; }
-		++count;
+		const auto value = static_cast<unsigned char>(character);
+		return ((bits[value >> 6] >> (value & 63)) & 1) != 0;
 	}
-	// remove as many characters as there are matches
-	value.resize(value.size() - count);
-}
+};
 
+// The largest set of characters that mtl::detail::count_front_in_set and 
+// mtl::detail::count_back_in_set compare with SIMD, larger sets use only the mtl::detail::char_set.
+constexpr size_t set_simd_max_size = 8;
 
-/// Strips all matching characters from the front and back side of the string. Performs
-/// no heap allocation.
-/// @param[in, out] value An std::string to strip from the front and back.
-/// @param[in] match An optional character to remove if it matches.
-inline void strip(std::string& value, const char match = ' ')
+// Returns the number of characters at the start of the given memory that are part of the set of
+// characters. When SIMD is available and the set is small 16 characters are checked at a time by
+// comparing them with every character of the set.
+[[nodiscard]]
+inline size_t count_front_in_set(const char* data, const size_t size, 
+								 std::string_view characters) noexcept
 {
-	// strip the back first so the strip_front has to copy fewer characters
-	strip_back(value, match);
-	strip_front(value, match);
-}
-
+	if (characters.empty()) { return 0; }
+	size_t i = 0;
 
+#if defined(MTL_SIMD_SSE2)
+	if (characters.size() <= set_simd_max_size)
+	{
+		const size_t set_size = characters.size();
+		__m128i patterns[set_simd_max_size];
+		for (size_t j = 0; j < set_size; ++j)
+		{
+			patterns[j] = _mm_set1_epi8(characters[j]);
+		}
 
-// ================================================================================================
-// PAD_FRONT     - Pads a string's front side with a given character for a number of times.
-// PAD_FRONT     - Pads a string's front side with a given character until it matches another
-//                 string's size.
-// PAD_BACK      - Pads a string's back side with a given character for a number of times.
-// PAD_BACK      - Pads a string's back side with a given character until it matches another
-//                 string's size.
-// PAD           - Pads a string's front and back side with a given character for a number of times
-//                 so it is centered in the middle.
-// PAD           - Pads a string's front and back side with a given character for a number of times
-//                 until it matches another string's size and is also centered in the middle.
-// ================================================================================================
+		while ((i + 16) <= size)
+		{
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i in_set = _mm_cmpeq_epi8(block, patterns[0]);
+			for (size_t j = 1; j < set_size; ++j)
+			{
+				in_set = _mm_or_si128(in_set, _mm_cmpeq_epi8(block, patterns[j]));
+			}
+			// each bit of the mask is set if the character at that position is not in the set
+			const auto mask = (~static_cast<uint32_t>(_mm_movemask_epi8(in_set))) & 0xFFFFu;
+			if (mask != 0) { return i + trailing_zeros(mask); }
+			i += 16;
+		}
+	}
+#endif // MTL_SIMD_SSE2 end
 
+	// process the remaining characters one at a time
+	const char_set set(characters);
+	for (; i < size; ++i)
+	{
+		if (set.contains(data[i]) == false)
+		{
+			return i;
+		}
+	}
+	return size;
+}
 
-/// Pads a string's front side with a given character for a number of times.
-/// @param[in, out] value An std::string to pad to the front.
-/// @param[in] times The number of times to perform the pad.
-/// @param[in] character An optional character to pad with.
-inline void pad_front(std::string& value, const size_t times, const char character = ' ')
+// Returns the number of characters at the end of the given memory that are part of the set of
+// characters. When SIMD is available and the set is small 16 characters are checked at a time by
+// comparing them with every character of the set.
+[[nodiscard]]
+inline size_t count_back_in_set(const char* data, const size_t size, 
+								std::string_view characters) noexcept
 {
-	// keep the original size
-	const auto old_size = value.size();
-	// resize the string to fit new characters
-	value.resize(value.size() + times);
-	// perform work on the string only if it is of a certain length and larger
-	if (value.size() > 1)
+	if (characters.empty()) { return 0; }
+	size_t i = 0;
+
+#if defined(MTL_SIMD_SSE2)
+	if (characters.size() <= set_simd_max_size)
 	{
-		// GCOVR_EXCL_START
-		using std_string_diff_type = std::string::difference_type;
-		// iterator to the destination we want
-		auto dest = std::next(value.begin(), static_cast<std_string_diff_type>(times));
-		// iterator to the position where the old string ended
-		auto it_end = std::next(value.begin(), static_cast<std_string_diff_type>(old_size));
-		// copy the string to the correct position
-		std::copy(value.begin(), it_end, dest);
-		// fill the given character to the correct positions
-		std::fill(value.begin(), dest, character);
-		// GCOVR_EXCL_STOP
+		const size_t set_size = characters.size();
+		__m128i patterns[set_simd_max_size];
+		for (size_t j = 0; j < set_size; ++j)
+		{
+			patterns[j] = _mm_set1_epi8(characters[j]);
+		}
+
+		while ((i + 16) <= size)
+		{
+			const char* start = data + (size - i - 16);
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+			__m128i in_set = _mm_cmpeq_epi8(block, patterns[0]);
+			for (size_t j = 1; j < set_size; ++j)
+			{
+				in_set = _mm_or_si128(in_set, _mm_cmpeq_epi8(block, patterns[j]));
+			}
+			// each bit of the mask is set if the character at that position is not in the set
+			const auto mask = (~static_cast<uint32_t>(_mm_movemask_epi8(in_set))) & 0xFFFFu;
+			if (mask != 0) { return i + (15 - highest_bit(mask)); }
+			i += 16;
+		}
 	}
+#endif // MTL_SIMD_SSE2 end
 
+	// process the remaining characters one at a time
+	const char_set set(characters);
+	while ((i < size) && (set.contains(data[size - i - 1])))
+	{
+		++i;
+	}
+	return i;
 }
 
-/// Pads a string's front side with a given character as many number of times is needed
-/// to match another string's size.
-/// @param[in, out] value An std::string to pad to the front.
-/// @param[in] match an std::string to match the size of.
-/// @param[in] character An optional character to pad with.
-inline void pad_front(std::string& value, const std::string& match, const char character = ' ')
+// Returns an std::string_view of a const char* without copying it. Throws std::logic_error if the
+// const char* is nullptr, the same as mtl::string::to_string does.
+[[nodiscard]]
+inline std::string_view to_string_view(const char* value)
 {
-	// we only want to resize if the target string's size is larger that the size of the string we
-	// want to match
-	if (match.size() > value.size())
+	if(value == nullptr)
 	{
-		// calculate the difference between the two strings size
-		const auto difference = match.size() - value.size();
-		pad_front(value, difference, character);
+		throw std::logic_error("The const char* is nullptr."); // GCOVR_EXCL_LINE
 	}
+	return std::string_view(value);
 }
 
-/// Pads a string's back side with a given character for a number of times.
-/// @param[in, out] value An std::string to pad to the back.
-/// @param[in] times The number of times to perform the pad.
-/// @param[in] match An optional character to pad with.
-/// @param[in] character An optional character to pad with.
-inline void pad_back(std::string& value, const size_t times, const char character = ' ')
-{
-	// resizes a string and fills it with a given character, if the string's capacity is large
-	// enough it may even avoid copying memory
-	value.resize(value.size() + times, character);
-}
+// ------------------------------------------------------------------------------------------------
+// Helper functions that split work between multiple threads.
+// ------------------------------------------------------------------------------------------------
 
-/// Pads a string's back side with a given character as many number of times is
-/// needed to match another string's size.
-/// @param[in, out] value An std::string to pad to the back.
-/// @param[in] match an std::string to match the size of.
-/// @param[in] character An optional character to pad with.
-inline void pad_back(std::string& value, const std::string& match, const char character = ' ')
+// Returns the number of threads to use. When the requested number of threads is 0 the number
+// of hardware threads is used instead.
+inline size_t parallel_thread_count(const size_t requested_threads)
 {
-	// we only want to perform work if the size of the string we are matching is bigger than the 
-	// input string
-	if (match.size() > value.size())
+	if (requested_threads > 0)
 	{
-		// calculate the difference between the two strings size
-		const auto difference = match.size() - value.size();
-		pad_back(value, difference, character);
+		return requested_threads;
 	}
+
+	const size_t hardware_threads = static_cast<size_t>(std::thread::hardware_concurrency());
+	// hardware_concurrency returns 0 when the number of threads can't be detected
+	if (hardware_threads == 0) { return 1; } // GCOVR_EXCL_LINE
+	return hardware_threads;
 }
 
-/// Pads a string's front and back side with a given character for a number of times so the string
-/// is centered in the middle. The variable times represents how many times it will be padded in
-/// total both on the front and on the back side. If more_back is set to true it will prefer to
-/// pad the back side more if the times that padding needs to be applied is an odd number.
-/// @param[in, out] value An std::string to pad to the front and back.
-/// @param[in] times The number of times to perform the pad.
-/// @param[in] character An optional character to pad with.
-/// @param[in] more_back If there should be more padding to the back side.
-inline void pad(std::string& value, const size_t times, const char character = ' ', 
-				bool more_back = false)
+// Calls the function once for each index from 0 up to but not including count, every index on
+// a different thread. The calling thread handles the index 0 and any index a thread couldn't be
+// started for. Waits for all threads to finish and then rethrows the first exception thrown by
+// any of the calls, if there was one.
+template<typename Function>
+inline void run_parallel(const size_t count, Function&& function)
 {
-	// if we are padding an empty string for more than 0 times then just use mtl::string::pad_back
-	if((value.empty()) && (times > 0))
+	std::vector<std::exception_ptr> exceptions(count);
+	std::vector<std::thread> threads;
+	threads.reserve(count);
+
+	// exceptions can't leave a thread so store them to be rethrown later
+	auto run_index = [&function, &exceptions](const size_t index)
 	{
-		mtl::string::pad_back(value, times, character);
-		return;
+		try
+		{
+			function(index);
+		}
+		catch (...) // GCOVR_EXCL_LINE
+		{
+			exceptions[index] = std::current_exception(); // GCOVR_EXCL_LINE
+		}
+	};
+
+	// the index of the first call that doesn't have a thread of its own
+	size_t first_inline = count;
+	for (size_t i = 1; i < count; ++i)
+	{
+		// if a thread can't be started the threads already running still have to be joined, so
+		// instead of throwing the calling thread does the rest of the work itself
+		try
+		{
+			threads.emplace_back(run_index, i);
+		}
+		catch (...) // GCOVR_EXCL_LINE
+		{
+			first_inline = i; // GCOVR_EXCL_LINE
+			break; // GCOVR_EXCL_LINE
+		}
 	}
-	// perform work only if the string has any character and if the times to pad is larger than 0
-	if ((value.empty() == false) && (times > 0))
+
+	// the calling thread also does its part of the work instead of just waiting
+	run_index(size_t(0));
+	for (size_t i = first_inline; i < count; ++i)
 	{
+		run_index(i); // GCOVR_EXCL_LINE
+	}
 
-		// convert to floating point for improved division quality
-		float back_pad_d = static_cast<float>(times);
-		// find the middle, we need to divide by 2 but because division is slower than
-		// multiplication we instead perform division by a constant number using multiplication
-		back_pad_d = back_pad_d * 0.5f;
-		
-		// keeps track how many times to pad the back side
-		size_t back_pad = 0;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
 
-		// if the more_back is false the padding will be centered but in the in case the padding
-		// isn't even it will have more padding to the front
-		if(more_back == false)
-		{
-			// round the result and convert it back to an integral number type
-			back_pad = static_cast<size_t>(std::floor(back_pad_d));
-		}
-		// if the more_back is true the padding will be centered but in the in case the padding
-		// isn't even it will have more padding to the back
-		else
+	for (const auto& exception : exceptions)
+	{
+		if (exception)
 		{
-			// round the result and convert it back to an integral number type
-			back_pad = static_cast<size_t>(std::ceil(back_pad_d));
+			std::rethrow_exception(exception); // GCOVR_EXCL_LINE
 		}
-		
+	}
+}
 
-		// find the times to pad the front
-		size_t front_pad = times - back_pad;
-		
-		// pad the front side first because it is slower as it is most likely to copy memory, and
-		// the string is a smaller size here than it will be in the end
-		pad_front(value, front_pad, character);
-		// pad the back
-		pad_back(value, back_pad, character);
+} // namespace detail end
+
+
+namespace string
+{
+
+// ================================================================================================
+// IS_UPPER - Returns if a character is an uppercase ASCII character.
+// IS_UPPER - Returns if all characters in an std::string are uppercase ASCII characters.
+// IS_LOWER - Returns if a character is a lowercase ASCII character.
+// IS_LOWER - Returns if all characters in an std::string are lowercase ASCII characters.
+// ================================================================================================
+
+/// Returns if a character is an uppercase ASCII character.
+/// @param[in] character A character to check.
+/// @return If the character is an uppercase ASCII character.
+[[nodiscard]]
+inline bool is_upper(const char character) noexcept
+{
+	int value = static_cast<int>(static_cast<unsigned char>(character));
+	if ((value >= 65) && (value <= 90))
+	{
+		return true;
 	}
+	return false;
 }
 
-/// Pads a string to it's front and back with a given character as many number of times is
-/// needed to match another string's size and is also centered in the middle. If more_back is set
-/// to true it will prefer to pad the back side more if the times that padding needs to be applied
-/// is an odd number.
-/// @param[in, out] value An std::string to pad to the front and back.
-/// @param[in] match an std::string to match the size of.
-/// @param[in] character An optional character to pad with.
-/// @param[in] more_back If there should be more padding to the back side.
-inline void pad(std::string& value, const std::string& match, const char character = ' ', 
-				bool more_back = false)
+/// Returns if all characters in an std::string are uppercase ASCII characters.
+/// @param[in] value An std::string_view to check.
+/// @return If all the characters are uppercase ASCII characters.
+[[nodiscard]]
+inline bool is_upper(std::string_view value) noexcept
 {
-	// we only want to perform work if the size of the string we are matching is bigger than the 
-	// input string
-	if (match.size() > value.size())
+	// the ranges of characters that are allowed, checked for many characters at a time
+	return mtl::detail::all_in_ranges<'A', 'Z'>(value.data(), value.size());
+}
+
+
+/// Returns if a character is a lowercase ASCII character.
+/// @param[in] character A character to check.
+/// @return If the character is a lowercase ASCII character.
+[[nodiscard]]
+inline bool is_lower(const char character) noexcept
+{
+	int value = static_cast<int>(static_cast<unsigned char>(character));
+	if ((value >= 97) && (value <= 122))
 	{
-		// calculate the difference between the two strings size
-		const auto difference = match.size() - value.size();
-		// pad the string
-		pad(value, difference, character, more_back);
+		return true;
 	}
+	return false;
 }
 
+/// Returns if all characters in an std::string are lowercase ASCII characters.
+/// @param[in] value An std::string_view to check.
+/// @return If all the characters are lowercase ASCII characters.
+[[nodiscard]]
+inline bool is_lower(std::string_view value) noexcept
+{
+	// the ranges of characters that are allowed, checked for many characters at a time
+	return mtl::detail::all_in_ranges<'a', 'z'>(value.data(), value.size());
+}
 
 
 // ================================================================================================
-// TO_STRING - convert various types to string
+// TO_UPPER - Converts a lowercase ASCII character to uppercase.
+// TO_UPPER - Converts all lowercase ASCII characters of an std::string to uppercase.
+// TO_LOWER - Converts an uppercase ASCII character to lowercase.
+// TO_LOWER - Converts all uppercase ASCII characters of an std::string to lowercase.
 // ================================================================================================
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
-template<typename T>
-[[nodiscard]]
-inline std::enable_if_t<!mtl::is_number_v<T>, std::string>
-to_string(const T& value)
+/// Converts a lowercase ASCII character to uppercase.
+/// @param[in, out] character A character to convert to uppercase.
+inline void to_upper(char& character) noexcept
 {
-	return fmt::to_string(value);
+	if (is_lower(character))
+	{
+		int value = static_cast<int>(static_cast<unsigned char>(character));
+		// it so happens that in an ASCII table the uppercase characters are 32 positions before 
+		// lowercase characters
+		value = value - 32;
+		character = static_cast<char>(value);
+	}
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
-template<typename T>
-[[nodiscard]]
-inline std::enable_if_t<mtl::is_int_v<T>, std::string>
-to_string(const T& value)
+/// Converts all lowercase ASCII characters in an std::string to uppercase.
+/// @param[in, out] value An std::string to convert all it's characters to uppercase.
+inline void to_upper(std::string& value) noexcept
 {
-	return fmt::format_int(value).str(); // GCOVR_EXCL_LINE
+	// flip the case of all lowercase characters, many characters at a time
+	mtl::detail::flip_case_in_range<'a', 'z'>(value.data(), value.size());
+}
+
+/// Converts an uppercase ASCII character to lowercase.
+/// @param[in, out] character A character to convert to lowercase.
+inline void to_lower(char& character) noexcept
+{
+	if (is_upper(character))
+	{
+		int value = static_cast<int>(static_cast<unsigned char>(character));
+		// it so happens that in an ASCII table the lowercase characters are 32 positions after 
+		// uppercase characters
+		value = value + 32;
+		character = static_cast<char>(value);
+	}
+}
+
+/// Converts all uppercase ASCII characters of an std::string to lowercase characters.
+/// @param[in, out] value An std::string to convert all it's characters to lowercase.
+inline void to_lower(std::string& value) noexcept
+{
+	// flip the case of all uppercase characters, many characters at a time
+	mtl::detail::flip_case_in_range<'A', 'Z'>(value.data(), value.size());
 }
 
 
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
-template<typename T>
+// ================================================================================================
+// IS_ASCII - Returns if char is an ASCII character.
+// IS_ASCII - Returns if all characters in an std::string are ASCII characters.
+// ================================================================================================
+
+/// Returns if the character is an ASCII character.
+/// @param[in] character A character to check.
+/// @return If the character is an ASCII character.
 [[nodiscard]]
-inline std::enable_if_t<mtl::is_float_v<T>, std::string>
-to_string(const T& value)
+inline bool is_ascii(const char character) noexcept
 {
-	return fmt::to_string(value);
+	int value = static_cast<int>(static_cast<unsigned char>(character));
+	// is the value within the ASCII range of characters
+	if ((value >= 0) && (value <= 127)) // GCOVR_EXCL_LINE
+	{
+		return true;
+	}
+	return false;
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
+/// Returns if all the characters in an std::string are ASCII characters.
+/// @param[in] value An std::string_view to check.
+/// @return If all characters of the std::string are ASCII characters.
 [[nodiscard]]
-inline std::string to_string(const bool value)
-{ 
-	if(value)
+inline bool is_ascii(std::string_view value) noexcept
+{
+	return mtl::detail::all_ascii(value.data(), value.size());
+}
+
+
+
+// ================================================================================================
+// IS_ALPHABETIC - Returns if a character / all characters in std::string are ASCII alphabetic 
+//                 characters or not.
+// IS_NUMERIC    - Returns if a character / all characters in std::string are ASCII numbers or not.
+// IS_ALPHANUM   - Returns if a character / all characters in std::string are ASCII alphanumeric 
+//                 characters or not.
+// ================================================================================================
+
+/// Returns if a character is an ASCII alphabetic character.
+/// @param[in] character A character to check.
+/// @return If the character is an ASCII alphabetic character.
+[[nodiscard]]
+inline bool is_alphabetic(const char character) noexcept
+{
+	int value = static_cast<int>(static_cast<unsigned char>(character));
+	if (((value >= 65) && (value <= 90)) || ((value >= 97) && (value <= 122)))
 	{
-		return std::string("true"); // GCOVR_EXCL_LINE
+		return true;
 	}
-	return std::string("false"); // GCOVR_EXCL_LINE
+	return false;
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
+/// Returns if all characters in an std::string are ASCII alphabetic characters.
+/// @param[in] value An std::string_view to check.
+/// @return If all the characters of an std::string are ASCII alphabetic characters.
 [[nodiscard]]
-inline std::string to_string(const std::string& value) 
-{ 
-	return value; 
+inline bool is_alphabetic(std::string_view value) noexcept
+{
+	// the ranges of characters that are allowed, checked for many characters at a time
+	return mtl::detail::all_in_ranges<'A', 'Z', 'a', 'z'>(value.data(), value.size());
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
+/// Returns if a character is an ASCII number.
+/// @param[in] character A character to check.
+/// @return If the character is an ASCII number.
 [[nodiscard]]
-inline std::string to_string(const char* value) 
-{ 
-	// if the const char* is nullptr throw because the conversion can't continue
-	if(value == nullptr)
+inline bool is_numeric(const char character) noexcept
+{
+	int value = static_cast<int>(static_cast<unsigned char>(character));
+	if ((value >= 48) && (value <= 57))
 	{
-		throw std::logic_error("The const char* is nullptr."); // GCOVR_EXCL_LINE
+		return true;
 	}
-	return std::string(value); // GCOVR_EXCL_LINE
+	return false;
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream.
-/// @param[in] value Any type that can be converted to std::string.
-/// @return An std::string.
+/// Returns if all characters in an std::string are ASCII numbers.
+/// @param[in] value An std::string_view to check.
+/// @return If all the characters of an std::string are ASCII numeric characters.
 [[nodiscard]]
-inline std::string to_string(const char value)
+inline bool is_numeric(std::string_view value) noexcept
 {
-	std::string result;
-	result.push_back(value); // GCOVR_EXCL_LINE
-	return result;
+	// the ranges of characters that are allowed, checked for many characters at a time
+	return mtl::detail::all_in_ranges<'0', '9'>(value.data(), value.size());
 }
 
-/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
-/// supports user defined types that have the operator<< overloaded for std::ostream. 
-/// Specialization for std::pair with extra option that allows to define a delimiter between the
-/// two items of the std::pair.
-/// @param[in] value Any type that can be converted to std::string.
-/// @param[in] delimiter A delimiter that will be used between the pair.
-/// @return An std::string.
-template<typename T1, typename T2>
+/// Returns if a character is an ASCII alphabetic or numeric character.
+/// @param[in] character A character to check.
+/// @return If the character is an ASCII alphanumeric character.
 [[nodiscard]]
-inline std::string to_string(const std::pair<T1, T2>& value, const std::string& delimiter = ", ")
+inline bool is_alphanum(const char character) noexcept
+{
+	if ((is_alphabetic(character))	|| (is_numeric(character)))
+	{
+		return true;
+	}
+	return false;
+}
+
+/// Returns if all characters in an std::string are ASCII alphabetic or numeric characters.
+/// @param[in] value An std::string_view to check.
+/// @return If all the characters of an std::string are ASCII alphanumeric characters.
+[[nodiscard]]
+inline bool is_alphanum(std::string_view value) noexcept
+{
+	// the ranges of characters that are allowed, checked for many characters at a time
+	return mtl::detail::all_in_ranges<'0', '9', 'A', 'Z', 'a', 'z'>(value.data(), value.size());
+}
+
+
+// ================================================================================================
+// CONTAINS - Returns if a substring exists within a string. 
+// ================================================================================================
+
+
+/// Returns if a substring is found inside the input string or not.
+/// @param[in] value An std::string_view to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(std::string_view value, std::string_view match)
+{
+	if (mtl::detail::find_substring(value, match) != std::string::npos) 
+	{ 
+		return true; 
+	}
+	return false;
+}
+
+/// Returns if a substring is found inside the input string or not.
+/// @param[in] value An std::string_view to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(std::string_view value, const char* match)
+{
+	// handle the case when const char* is nullptr
+	if(match == nullptr)
+	{
+		return false;
+	}
+
+	// search for match
+	size_t pos = mtl::detail::find_substring(value, match);
+	if (pos != std::string::npos) 
+	{ 
+		return true; 
+	}
+	return false;
+}
+
+/// Returns if a char is found inside the input string or not.
+/// @param[in] value An std::string_view to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(std::string_view value, const char match)
+{
+	if (mtl::detail::find_char(value.data(), value.size(), match) != std::string::npos) 
+	{ 
+		return true; 
+	}
+	return false;
+}
+
+
+
+/// Returns if a substring is found inside the input string or not.
+/// @param[in] value A const char* to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(const char* value, const std::string& match)
+{
+	// handle the case when const char* is nullptr
+	if(value == nullptr)
+	{
+		return false;
+	}
+
+	// search for match
+	const auto pos = std::strstr(value, match.c_str());
+	if(pos != nullptr)
+	{
+		return true;
+	}
+	return false;
+}
+
+/// Returns if a substring is found inside the input string or not.
+/// @param[in] value A const char* to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(const char* value, const char* match)
+{
+	// handle the case when const char* is nullptr
+	if((value == nullptr) || (match == nullptr))
+	{
+		return false;
+	}
+
+	// search for match
+	const auto pos = std::strstr(value, match);
+	if(pos != nullptr)
+	{
+		return true;
+	}
+	return false;
+}
+
+
+/// Returns if a char is found inside the input string or not.
+/// @param[in] value An std::string to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains(const char* value, const char match)
+{
+	// handle the case when const char* is nullptr
+	if(value == nullptr)
+	{
+		return false;
+	}
+
+	if(std::strchr(value, static_cast<int>(match)) != nullptr)
+	{
+		return true;
+	} 	
+	return false;
+}
+
+
+
+
+// ================================================================================================
+// SEARCHER - Searches for the same substring many times.
+// ================================================================================================
+
+/// Searches for the same substring in many inputs. The match is copied and prepared once, so it is
+/// faster than repeatedly calling functions such as mtl::string::contains with the same match. The
+/// search uses SIMD when it is available to check many positions at a time for the first
+/// character of the match and for the last character that is different from the first one.
+class searcher
+{
+	// the substring to search for
+	std::string needle;
+	// the offset of the character in the needle used to filter positions together with the first
+	// character of the needle
+	size_t filter_offset = 0;
+
+public:
+
+	/// Default constructor. It searches for an empty substring that is found at the start of any
+	/// input.
+	searcher() = default;
+
+	/// Prepares to search for the given substring.
+	/// @param[in] match The substring to search for.
+	explicit searcher(std::string_view match) : needle(match)
+	{
+		if (needle.empty()) { return; }
+
+		// the last character that is different from the first character filters out more
+		// positions for repetitive matches, otherwise use the last character
+		filter_offset = needle.size() - 1;
+		for (size_t i = needle.size() - 1; i > 0; --i)
+		{
+			if (needle[i] != needle[0])
+			{
+				filter_offset = i;
+				break;
+			}
+		}
+	}
+
+
+	// ============================================================================================
+	// MATCH            - Returns the match that is searched for.
+	// ============================================================================================
+
+	/// Returns the substring this searcher searches for.
+	/// @return The substring to search for.
+	[[nodiscard]]
+	const std::string& match() const noexcept { return needle; }
+
+
+	// ============================================================================================
+	// SIZE             - Returns the size of the match.
+	// ============================================================================================
+
+	/// Returns the size of the substring this searcher searches for.
+	/// @return The size of the substring.
+	[[nodiscard]]
+	size_t size() const noexcept { return needle.size(); }
+
+
+	// ============================================================================================
+	// FIND             - Finds the first occurrence of the match.
+	// ============================================================================================
+
+	/// Returns the position of the first occurrence of the substring in the input starting from
+	/// the given position. It behaves exactly like the find member function of std::string.
+	/// @param[in] value The input to search.
+	/// @param[in] position The position in the input to start searching from.
+	/// @return The position of the match or std::string_view::npos if it wasn't found.
+	[[nodiscard]]
+	size_t find(std::string_view value, const size_t position = 0) const noexcept
+	{
+		if (position > value.size()) { return std::string_view::npos; }
+
+		const size_t found = mtl::detail::find_substring(value.data() + position,
+														 value.size() - position,
+														 needle.data(), needle.size(),
+														 filter_offset);
+		if (found == std::string_view::npos) { return found; }
+		return position + found;
+	}
+
+
+	// ============================================================================================
+	// CONTAINS         - Returns if the match is found.
+	// ============================================================================================
+
+	/// Returns if the substring is found inside the input.
+	/// @param[in] value The input to search.
+	/// @return If the match was found.
+	[[nodiscard]]
+	bool contains(std::string_view value) const noexcept
+	{
+		return find(value) != std::string_view::npos;
+	}
+
+
+	// ============================================================================================
+	// COUNT            - Counts the non-overlapping occurrences of the match.
+	// ============================================================================================
+
+	/// Returns the number of non-overlapping occurrences of the substring in the input. If the
+	/// substring is empty it returns 0.
+	/// @param[in] value The input to search.
+	/// @return The number of times the match was found.
+	[[nodiscard]]
+	size_t count(std::string_view value) const noexcept
+	{
+		if (needle.empty()) { return 0; }
+
+		size_t matches = 0;
+		size_t position = find(value);
+		while (position != std::string_view::npos)
+		{
+			++matches;
+			position = find(value, position + needle.size());
+		}
+		return matches;
+	}
+};
+
+
+
+
+// ================================================================================================
+// EQUALS_IGNORE_CASE      - Returns if two strings are the same ignoring ASCII case.
+// STARTS_WITH_IGNORE_CASE - Returns if a string starts with a match ignoring ASCII case.
+// ENDS_WITH_IGNORE_CASE   - Returns if a string ends with a match ignoring ASCII case.
+// FIND_IGNORE_CASE        - Finds the position of a substring ignoring ASCII case.
+// CONTAINS_IGNORE_CASE    - Returns if a substring exists within a string ignoring ASCII case.
+// REPLACE_IGNORE_CASE     - Replaces all matches ignoring ASCII case with the replacement.
+// ================================================================================================
+
+/// Returns if two strings are the same when the case of ASCII characters is ignored. The case is
+/// converted while comparing, so nothing is copied or allocated.
+/// @param[in] lhs An std::string_view to compare.
+/// @param[in] rhs An std::string_view to compare.
+/// @return If both strings are the same when ignoring case.
+[[nodiscard]]
+inline bool equals_ignore_case(std::string_view lhs, std::string_view rhs) noexcept
+{
+	if (lhs.size() != rhs.size()) { return false; }
+	return mtl::detail::equal_ignore_case(lhs.data(), rhs.data(), lhs.size());
+}
+
+/// Returns if the input starts with the match when the case of ASCII characters is ignored.
+/// @param[in] value An std::string_view to check.
+/// @param[in] match A match to check for at the start of the input.
+/// @return If the input starts with the match when ignoring case.
+[[nodiscard]]
+inline bool starts_with_ignore_case(std::string_view value, std::string_view match) noexcept
+{
+	if (match.size() > value.size()) { return false; }
+	return mtl::detail::equal_ignore_case(value.data(), match.data(), match.size());
+}
+
+/// Returns if the input ends with the match when the case of ASCII characters is ignored.
+/// @param[in] value An std::string_view to check.
+/// @param[in] match A match to check for at the end of the input.
+/// @return If the input ends with the match when ignoring case.
+[[nodiscard]]
+inline bool ends_with_ignore_case(std::string_view value, std::string_view match) noexcept
+{
+	if (match.size() > value.size()) { return false; }
+	const size_t start = value.size() - match.size();
+	return mtl::detail::equal_ignore_case(value.data() + start, match.data(), match.size());
+}
+
+/// Returns the position of the first occurrence of the match in the input starting from the given
+/// position when the case of ASCII characters is ignored. Other than ignoring case it behaves
+/// exactly like the find member function of std::string.
+/// @param[in] value An std::string_view to search.
+/// @param[in] match A match to search for.
+/// @param[in] position The position in the input to start searching from.
+/// @return The position of the match or std::string_view::npos if it wasn't found.
+[[nodiscard]]
+inline size_t find_ignore_case(std::string_view value, std::string_view match,
+							   const size_t position = 0) noexcept
+{
+	if (position > value.size()) { return std::string_view::npos; }
+
+	const size_t found = mtl::detail::find_substring_ignore_case(value.data() + position,
+																 value.size() - position,
+																 match.data(), match.size());
+	if (found == std::string_view::npos) { return found; }
+	return position + found;
+}
+
+/// Returns if a substring is found inside the input when the case of ASCII characters is ignored.
+/// @param[in] value An std::string_view to check for a match.
+/// @param[in] match A match to search in the input.
+/// @return If the match was found.
+[[nodiscard]]
+inline bool contains_ignore_case(std::string_view value, std::string_view match) noexcept
+{
+	return find_ignore_case(value, match) != std::string_view::npos;
+}
+
+/// Replaces all places in the input where a match is found with the replacement when the case of
+/// ASCII characters is ignored. The replacement is used exactly as it is given. If the match is
+/// empty nothing is replaced. The match and the replacement must not view the input.
+/// @param[in, out] value An std::string to replace parts that match with a replacement.
+/// @param[in] match A match to search for.
+/// @param[in] replacement A replacement to replace the matches with.
+/// @return The number of replacements.
+inline size_t replace_ignore_case(std::string& value, std::string_view match,
+								  std::string_view replacement)
+{
+	if (match.empty()) { return 0; }
+
+	size_t pos = find_ignore_case(value, match);
+	// if nothing is found leave without allocating
+	if (pos == std::string_view::npos) { return 0; }
+
+	std::string result;
+	result.reserve(value.size());
+	size_t count = 0;
+	size_t start = 0;
+	while (pos != std::string_view::npos)
+	{
+		// append the part before the match and then the replacement
+		result.append(value, start, pos - start);
+		result.append(replacement);
+		start = pos + match.size();
+		pos = find_ignore_case(value, match, start);
+		++count;
+	}
+
+	// append from the last match to the end
+	result.append(value, start, std::string::npos);
+	value.swap(result);
+	return count;
+}
+
+
+
+
+// ===============================================================================================
+// STRIP_FRONT       - Strips all matching characters from the front.
+// STRIP_BACK        - Strips all matching characters from the back.
+// STRIP             - Strips all matching characters from the front and back.
+// STRIP_FRONT_VIEW  - Returns a view without all matching characters at the front.
+// STRIP_BACK_VIEW   - Returns a view without all matching characters at the back.
+// STRIP_VIEW        - Returns a view without all matching characters at the front and back.
+// ===============================================================================================
+
+/// Strips all matching characters from the front side of the string. Performs no heap 
+/// allocation.
+/// @param[in, out] value An std::string to strip from the front.
+/// @param[in] match An optional character to remove if it matches.
+inline void strip_front(std::string& value, const char match = ' ')
+{
+	// count how many characters match
+	size_t count = 0;
+	for (const char character : value)
+	{
+		if (character != match) { break; }
+		++count;
+	}
+
+	// if there are no matches leave
+	if(count == 0)
+	{
+		return;
+	}
+
+	// if the number of characters matching are less that the length of the string
+	if (count < value.size())
+	{
+		// remove unwanted characters from the start
+		value.erase(0, count);
+	}
+	// else if the number of characters matching are equal to the length of the string
+	else
+	{
+		value.resize(0);
+	}
+}
+
+
+/// Strips all matching characters from the back side of the string. Performs no heap 
+/// allocation.
+/// @param[in, out] value An std::string to strip from the back.
+/// @param[in] match An optional character to remove if it matches.
+inline void strip_back(std::string& value, const char match = ' ')
+{
+	size_t count = 0;
+	// count how many character match from the end using reverse iterator
+	for (auto it = value.rbegin(); it != value.rend(); ++it)
+	{
+		if (*it != match) { break; }
+		++count;
+	}
+	// remove as many characters as there are matches
+	value.resize(value.size() - count);
+}
+
+
+/// Strips all matching characters from the front and back side of the string. Performs
+/// no heap allocation.
+/// @param[in, out] value An std::string to strip from the front and back.
+/// @param[in] match An optional character to remove if it matches.
+inline void strip(std::string& value, const char match = ' ')
+{
+	// strip the back first so the strip_front has to copy fewer characters
+	strip_back(value, match);
+	strip_front(value, match);
+}
+
+
+/// Returns a view of the input without all matching characters at the front side. Nothing is
+/// copied or allocated and the input isn't modified, so the input has to outlive the result.
+/// @param[in] value An std::string_view to strip from the front.
+/// @param[in] match An optional character to remove if it matches.
+/// @return An std::string_view of the input without the matching characters at the front.
+[[nodiscard]]
+inline std::string_view strip_front_view(std::string_view value, const char match = ' ') noexcept
+{
+	size_t count = 0;
+	while ((count < value.size()) && (value[count] == match))
+	{
+		++count;
+	}
+	value.remove_prefix(count);
+	return value;
+}
+
+/// Returns a view of the input without all matching characters at the back side. Nothing is
+/// copied or allocated and the input isn't modified, so the input has to outlive the result.
+/// @param[in] value An std::string_view to strip from the back.
+/// @param[in] match An optional character to remove if it matches.
+/// @return An std::string_view of the input without the matching characters at the back.
+[[nodiscard]]
+inline std::string_view strip_back_view(std::string_view value, const char match = ' ') noexcept
+{
+	size_t count = 0;
+	while ((count < value.size()) && (value[value.size() - count - 1] == match))
+	{
+		++count;
+	}
+	value.remove_suffix(count);
+	return value;
+}
+
+/// Returns a view of the input without all matching characters at the front and back side.
+/// Nothing is copied or allocated and the input isn't modified, so the input has to outlive the
+/// result.
+/// @param[in] value An std::string_view to strip from the front and back.
+/// @param[in] match An optional character to remove if it matches.
+/// @return An std::string_view of the input without the matching characters at both sides.
+[[nodiscard]]
+inline std::string_view strip_view(std::string_view value, const char match = ' ') noexcept
+{
+	return strip_front_view(strip_back_view(value, match), match);
+}
+
+
+
+// ===============================================================================================
+// STRIP_FRONT_ANY       - Strips all characters that are part of a set from the front.
+// STRIP_BACK_ANY        - Strips all characters that are part of a set from the back.
+// STRIP_ANY             - Strips all characters that are part of a set from the front and back.
+// STRIP_FRONT_ANY_VIEW  - Returns a view without all characters of a set at the front.
+// STRIP_BACK_ANY_VIEW   - Returns a view without all characters of a set at the back.
+// STRIP_ANY_VIEW        - Returns a view without all characters of a set at the front and back.
+// ===============================================================================================
+
+namespace detail
+{
+
+// All the ASCII whitespace characters, space, tab, newline, vertical tab, form feed and carriage
+// return.
+constexpr std::string_view ascii_whitespace = " \t\n\v\f\r";
+
+} // namespace detail end
+
+/// Strips all characters that are part of the set of characters from the front side of the
+/// string. By default it strips all ASCII whitespace. Performs no heap allocation.
+/// @param[in, out] value An std::string to strip from the front.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+inline void strip_front_any(std::string& value, 
+							std::string_view characters = mtl::string::detail::ascii_whitespace)
+{
+	const size_t count = mtl::detail::count_front_in_set(value.data(), value.size(), characters);
+	value.erase(0, count);
+}
+
+/// Strips all characters that are part of the set of characters from the back side of the 
+/// string. By default it strips all ASCII whitespace. Performs no heap allocation.
+/// @param[in, out] value An std::string to strip from the back.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+inline void strip_back_any(std::string& value, 
+						   std::string_view characters = mtl::string::detail::ascii_whitespace)
+{
+	const size_t count = mtl::detail::count_back_in_set(value.data(), value.size(), characters);
+	value.resize(value.size() - count);
+}
+
+/// Strips all characters that are part of the set of characters from the front and back side of
+/// the string. By default it strips all ASCII whitespace. Performs no heap allocation.
+/// @param[in, out] value An std::string to strip from the front and back.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+inline void strip_any(std::string& value, 
+					  std::string_view characters = mtl::string::detail::ascii_whitespace)
+{
+	// strip the back first so the strip_front_any has to copy fewer characters
+	strip_back_any(value, characters);
+	strip_front_any(value, characters);
+}
+
+/// Returns a view of the input without all characters that are part of the set of characters at
+/// the front side. By default it strips all ASCII whitespace. Nothing is copied or allocated and
+/// the input isn't modified, so the input has to outlive the result.
+/// @param[in] value An std::string_view to strip from the front.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+/// @return An std::string_view of the input without the characters of the set at the front.
+[[nodiscard]]
+inline std::string_view 
+strip_front_any_view(std::string_view value,
+					 std::string_view characters = mtl::string::detail::ascii_whitespace) noexcept
+{
+	value.remove_prefix(mtl::detail::count_front_in_set(value.data(), value.size(), characters));
+	return value;
+}
+
+/// Returns a view of the input without all characters that are part of the set of characters at
+/// the back side. By default it strips all ASCII whitespace. Nothing is copied or allocated and
+/// the input isn't modified, so the input has to outlive the result.
+/// @param[in] value An std::string_view to strip from the back.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+/// @return An std::string_view of the input without the characters of the set at the back.
+[[nodiscard]]
+inline std::string_view 
+strip_back_any_view(std::string_view value,
+					std::string_view characters = mtl::string::detail::ascii_whitespace) noexcept
+{
+	value.remove_suffix(mtl::detail::count_back_in_set(value.data(), value.size(), characters));
+	return value;
+}
+
+/// Returns a view of the input without all characters that are part of the set of characters at
+/// the front and back side. By default it strips all ASCII whitespace. Nothing is copied or 
+/// allocated and the input isn't modified, so the input has to outlive the result.
+/// @param[in] value An std::string_view to strip from the front and back.
+/// @param[in] characters An optional set of characters to remove, all ASCII whitespace by default.
+/// @return An std::string_view of the input without the characters of the set at both sides.
+[[nodiscard]]
+inline std::string_view 
+strip_any_view(std::string_view value,
+			   std::string_view characters = mtl::string::detail::ascii_whitespace) noexcept
+{
+	return strip_back_any_view(strip_front_any_view(value, characters), characters);
+}
+
+
+
+// ================================================================================================
+// PAD_FRONT     - Pads a string's front side with a given character for a number of times.
+// PAD_FRONT     - Pads a string's front side with a given character until it matches another
+//                 string's size.
+// PAD_BACK      - Pads a string's back side with a given character for a number of times.
+// PAD_BACK      - Pads a string's back side with a given character until it matches another
+//                 string's size.
+// PAD           - Pads a string's front and back side with a given character for a number of times
+//                 so it is centered in the middle.
+// PAD           - Pads a string's front and back side with a given character for a number of times
+//                 until it matches another string's size and is also centered in the middle.
+// ================================================================================================
+
+
+/// Pads a string's front side with a given character for a number of times.
+/// @param[in, out] value An std::string to pad to the front.
+/// @param[in] times The number of times to perform the pad.
+/// @param[in] character An optional character to pad with.
+inline void pad_front(std::string& value, const size_t times, const char character = ' ')
+{
+	// keep the original size
+	const auto old_size = value.size();
+	// resize the string to fit new characters
+	value.resize(value.size() + times);
+	// perform work on the string only if it is of a certain length and larger
+	if (value.size() > 1)
+	{
+		// GCOVR_EXCL_START
+		using std_string_diff_type = std::string::difference_type;
+		// iterator to the destination we want
+		auto dest = std::next(value.begin(), static_cast<std_string_diff_type>(times));
+		// iterator to the position where the old string ended
+		auto it_end = std::next(value.begin(), static_cast<std_string_diff_type>(old_size));
+		// copy the string to the correct position
+		std::copy(value.begin(), it_end, dest);
+		// fill the given character to the correct positions
+		std::fill(value.begin(), dest, character);
+		// GCOVR_EXCL_STOP
+	}
+
+}
+
+/// Pads a string's front side with a given character as many number of times is needed
+/// to match another string's size.
+/// @param[in, out] value An std::string to pad to the front.
+/// @param[in] match An std::string_view to match the size of.
+/// @param[in] character An optional character to pad with.
+inline void pad_front(std::string& value, std::string_view match, const char character = ' ')
+{
+	// we only want to resize if the target string's size is larger that the size of the string we
+	// want to match
+	if (match.size() > value.size())
+	{
+		// calculate the difference between the two strings size
+		const auto difference = match.size() - value.size();
+		pad_front(value, difference, character);
+	}
+}
+
+/// Pads a string's back side with a given character for a number of times.
+/// @param[in, out] value An std::string to pad to the back.
+/// @param[in] times The number of times to perform the pad.
+/// @param[in] match An optional character to pad with.
+/// @param[in] character An optional character to pad with.
+inline void pad_back(std::string& value, const size_t times, const char character = ' ')
+{
+	// resizes a string and fills it with a given character, if the string's capacity is large
+	// enough it may even avoid copying memory
+	value.resize(value.size() + times, character);
+}
+
+/// Pads a string's back side with a given character as many number of times is
+/// needed to match another string's size.
+/// @param[in, out] value An std::string to pad to the back.
+/// @param[in] match An std::string_view to match the size of.
+/// @param[in] character An optional character to pad with.
+inline void pad_back(std::string& value, std::string_view match, const char character = ' ')
+{
+	// we only want to perform work if the size of the string we are matching is bigger than the 
+	// input string
+	if (match.size() > value.size())
+	{
+		// calculate the difference between the two strings size
+		const auto difference = match.size() - value.size();
+		pad_back(value, difference, character);
+	}
+}
+
+/// Pads a string's front and back side with a given character for a number of times so the string
+/// is centered in the middle. The variable times represents how many times it will be padded in
+/// total both on the front and on the back side. If more_back is set to true it will prefer to
+/// pad the back side more if the times that padding needs to be applied is an odd number.
+/// @param[in, out] value An std::string to pad to the front and back.
+/// @param[in] times The number of times to perform the pad.
+/// @param[in] character An optional character to pad with.
+/// @param[in] more_back If there should be more padding to the back side.
+inline void pad(std::string& value, const size_t times, const char character = ' ', 
+				bool more_back = false)
+{
+	// if we are padding an empty string for more than 0 times then just use mtl::string::pad_back
+	if((value.empty()) && (times > 0))
+	{
+		mtl::string::pad_back(value, times, character);
+		return;
+	}
+	// perform work only if the string has any character and if the times to pad is larger than 0
+	if ((value.empty() == false) && (times > 0))
+	{
+
+		// convert to floating point for improved division quality
+		float back_pad_d = static_cast<float>(times);
+		// find the middle, we need to divide by 2 but because division is slower than
+		// multiplication we instead perform division by a constant number using multiplication
+		back_pad_d = back_pad_d * 0.5f;
+		
+		// keeps track how many times to pad the back side
+		size_t back_pad = 0;
+
+		// if the more_back is false the padding will be centered but in the in case the padding
+		// isn't even it will have more padding to the front
+		if(more_back == false)
+		{
+			// round the result and convert it back to an integral number type
+			back_pad = static_cast<size_t>(std::floor(back_pad_d));
+		}
+		// if the more_back is true the padding will be centered but in the in case the padding
+		// isn't even it will have more padding to the back
+		else
+		{
+			// round the result and convert it back to an integral number type
+			back_pad = static_cast<size_t>(std::ceil(back_pad_d));
+		}
+		
+
+		// find the times to pad the front
+		size_t front_pad = times - back_pad;
+		
+		// pad the front side first because it is slower as it is most likely to copy memory, and
+		// the string is a smaller size here than it will be in the end
+		pad_front(value, front_pad, character);
+		// pad the back
+		pad_back(value, back_pad, character);
+	}
+}
+
+/// Pads a string to it's front and back with a given character as many number of times is
+/// needed to match another string's size and is also centered in the middle. If more_back is set
+/// to true it will prefer to pad the back side more if the times that padding needs to be applied
+/// is an odd number.
+/// @param[in, out] value An std::string to pad to the front and back.
+/// @param[in] match An std::string_view to match the size of.
+/// @param[in] character An optional character to pad with.
+/// @param[in] more_back If there should be more padding to the back side.
+inline void pad(std::string& value, std::string_view match, const char character = ' ', 
+				bool more_back = false)
+{
+	// we only want to perform work if the size of the string we are matching is bigger than the 
+	// input string
+	if (match.size() > value.size())
+	{
+		// calculate the difference between the two strings size
+		const auto difference = match.size() - value.size();
+		// pad the string
+		pad(value, difference, character, more_back);
+	}
+}
+
+
+
+// ================================================================================================
+// PAD_FRONT_ALL - Pads the front side of all strings in a range to the same width and joins them.
+// PAD_BACK_ALL  - Pads the back side of all strings in a range to the same width and joins them.
+// PAD_ALL       - Pads the front and back side of all strings in a range to the same width so
+//                 they are centered in the middle and joins them.
+// ================================================================================================
+
+namespace detail
+{
+
+// The side to pad for mtl::string::detail::pad_all_impl.
+enum class pad_side
+{
+	front,
+	back,
+	middle_more_front,
+	middle_more_back
+};
+
+// Returns an std::string_view of an element of a range of strings. Throws std::logic_error if the
+// element is a const char* that is nullptr.
+template<typename Type>
+[[nodiscard]]
+inline std::string_view pad_element_view(const Type& value)
+{
+	if constexpr (std::is_convertible_v<const Type&, const char*>)
+	{
+		return mtl::detail::to_string_view(value);
+	}
+	else
+	{
+		return std::string_view(value);
+	}
+}
+
+// Pads all strings in a range to the same width with the given side and appends them with a 
+// delimiter between them to the result. When the width is 0 the size of the longest string is
+// used. The result grows once to its exact size and is filled with the padding character by
+// std::string::resize, which uses a vectorized fill, so afterwards only the strings and the 
+// delimiters have to be copied to their positions.
+template<typename Iter>
+inline void pad_all_impl(Iter first, Iter last, std::string& result, size_t width, 
+						 const char character, std::string_view delimiter, const pad_side side)
+{
+	if (first == last) { return; }
+
+	// find the total size of the strings after padding and the number of strings, and if no
+	// width was given find the size of the longest string to use as width
+	size_t elements = 0;
+	size_t longest = 0;
+	size_t padded_size = 0;
+	for (auto it = first; it != last; ++it)
+	{
+		const size_t size = pad_element_view(*it).size();
+		if (size > longest)
+		{
+			longest = size;
+		}
+		// strings longer than the width keep their size
+		if (size > width)
+		{
+			padded_size += size;
+		}
+		else
+		{
+			padded_size += width;
+		}
+		++elements;
+	}
+	if (width == 0)
+	{
+		width = longest;
+		padded_size = longest * elements;
+	}
+
+	const size_t delim_size = delimiter.size();
+	size_t position = result.size();
+	result.resize(position + padded_size + (delim_size * (elements - 1)), character);
+	char* output = result.data();
+
+	for (auto it = first; it != last; ++it)
+	{
+		if (it != first)
+		{
+			std::memcpy(output + position, delimiter.data(), delim_size);
+			position += delim_size;
+		}
+
+		const std::string_view element = pad_element_view(*it);
+		const size_t size = element.size();
+		// strings longer than the width are not padded
+		size_t padding = 0;
+		if (width > size)
+		{
+			padding = width - size;
+		}
+
+		// find how much padding goes before the string, the rest goes after it
+		size_t front_padding = 0;
+		if (side == pad_side::front)
+		{
+			front_padding = padding;
+		}
+		else if (side == pad_side::middle_more_front)
+		{
+			front_padding = padding - (padding / 2);
+		}
+		else if (side == pad_side::middle_more_back)
+		{
+			front_padding = padding / 2;
+		}
+
+		if (size > 0)
+		{
+			std::memcpy(output + position + front_padding, element.data(), size);
+		}
+		position += size + padding;
+	}
+}
+
+} // namespace detail end
+
+
+/// Pads the front side of all strings in a range to the same width with a given character and
+/// appends them to the result with a delimiter between them, growing the result only once. When
+/// the width is 0 the size of the longest string is used as width. Strings longer than the width
+/// are not padded. The elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the padded strings will be appended.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+template<typename Iter>
+inline void pad_front_all(Iter first, Iter last, std::string& result, const size_t width = 0,
+						  const char character = ' ', std::string_view delimiter = "")
+{
+	mtl::string::detail::pad_all_impl(first, last, result, width, character, delimiter,
+									  mtl::string::detail::pad_side::front);
+}
+
+/// Pads the front side of all strings in a range to the same width with a given character and
+/// returns them joined with a delimiter between them in an std::string. When the width is 0 the
+/// size of the longest string is used as width. Strings longer than the width are not padded. The
+/// elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+/// @return An std::string with all the padded strings.
+template<typename Iter>
+[[nodiscard]]
+inline std::string pad_front_all(Iter first, Iter last, const size_t width = 0, 
+								 const char character = ' ', std::string_view delimiter = "")
+{
+	std::string result;
+	mtl::string::pad_front_all(first, last, result, width, character, delimiter);
+	return result;
+}
+
+/// Pads the back side of all strings in a range to the same width with a given character and
+/// appends them to the result with a delimiter between them, growing the result only once. When
+/// the width is 0 the size of the longest string is used as width. Strings longer than the width
+/// are not padded. The elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the padded strings will be appended.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+template<typename Iter>
+inline void pad_back_all(Iter first, Iter last, std::string& result, const size_t width = 0,
+						 const char character = ' ', std::string_view delimiter = "")
+{
+	mtl::string::detail::pad_all_impl(first, last, result, width, character, delimiter,
+									  mtl::string::detail::pad_side::back);
+}
+
+/// Pads the back side of all strings in a range to the same width with a given character and
+/// returns them joined with a delimiter between them in an std::string. When the width is 0 the
+/// size of the longest string is used as width. Strings longer than the width are not padded. The
+/// elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+/// @return An std::string with all the padded strings.
+template<typename Iter>
+[[nodiscard]]
+inline std::string pad_back_all(Iter first, Iter last, const size_t width = 0, 
+								const char character = ' ', std::string_view delimiter = "")
+{
+	std::string result;
+	mtl::string::pad_back_all(first, last, result, width, character, delimiter);
+	return result;
+}
+
+/// Pads the front and back side of all strings in a range to the same width with a given 
+/// character so they are centered in the middle and appends them to the result with a delimiter
+/// between them, growing the result only once. When the width is 0 the size of the longest string
+/// is used as width. Strings longer than the width are not padded. If more_back is set to true it
+/// will prefer to pad the back side more if the padding needed is an odd number, the same as
+/// mtl::string::pad. The elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the padded strings will be appended.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+/// @param[in] more_back If there should be more padding to the back side.
+template<typename Iter>
+inline void pad_all(Iter first, Iter last, std::string& result, const size_t width = 0,
+					const char character = ' ', std::string_view delimiter = "", 
+					const bool more_back = false)
+{
+	auto side = mtl::string::detail::pad_side::middle_more_front;
+	if (more_back)
+	{
+		side = mtl::string::detail::pad_side::middle_more_back;
+	}
+	mtl::string::detail::pad_all_impl(first, last, result, width, character, delimiter, side);
+}
+
+/// Pads the front and back side of all strings in a range to the same width with a given 
+/// character so they are centered in the middle and returns them joined with a delimiter between
+/// them in an std::string. When the width is 0 the size of the longest string is used as width.
+/// Strings longer than the width are not padded. If more_back is set to true it will prefer to 
+/// pad the back side more if the padding needed is an odd number, the same as mtl::string::pad.
+/// The elements can be std::string, std::string_view or const char*.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] width The width to pad to, 0 to use the size of the longest string.
+/// @param[in] character An optional character to pad with.
+/// @param[in] delimiter An optional delimiter to use between the padded strings.
+/// @param[in] more_back If there should be more padding to the back side.
+/// @return An std::string with all the padded strings.
+template<typename Iter>
+[[nodiscard]]
+inline std::string pad_all(Iter first, Iter last, const size_t width = 0, 
+						   const char character = ' ', std::string_view delimiter = "", 
+						   const bool more_back = false)
+{
+	std::string result;
+	mtl::string::pad_all(first, last, result, width, character, delimiter, more_back);
+	return result;
+}
+
+
+
+// ================================================================================================
+// TO_STRING - convert various types to string
+// ================================================================================================
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+template<typename T>
+[[nodiscard]]
+inline std::enable_if_t<!mtl::is_number_v<T>, std::string>
+to_string(const T& value)
+{
+	return fmt::to_string(value);
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+template<typename T>
+[[nodiscard]]
+inline std::enable_if_t<mtl::is_int_v<T>, std::string>
+to_string(const T& value)
+{
+	return fmt::format_int(value).str(); // GCOVR_EXCL_LINE
+}
+
+
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+template<typename T>
+[[nodiscard]]
+inline std::enable_if_t<mtl::is_float_v<T>, std::string>
+to_string(const T& value)
+{
+	return fmt::to_string(value);
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+[[nodiscard]]
+inline std::string to_string(const bool value)
+{ 
+	if(value)
+	{
+		return std::string("true"); // GCOVR_EXCL_LINE
+	}
+	return std::string("false"); // GCOVR_EXCL_LINE
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+[[nodiscard]]
+inline std::string to_string(const std::string& value) 
+{ 
+	return value; 
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+[[nodiscard]]
+inline std::string to_string(const char* value) 
+{ 
+	// if the const char* is nullptr throw because the conversion can't continue
+	if(value == nullptr)
+	{
+		throw std::logic_error("The const char* is nullptr."); // GCOVR_EXCL_LINE
+	}
+	return std::string(value); // GCOVR_EXCL_LINE
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream.
+/// @param[in] value Any type that can be converted to std::string.
+/// @return An std::string.
+[[nodiscard]]
+inline std::string to_string(const char value)
+{
+	std::string result;
+	result.push_back(value); // GCOVR_EXCL_LINE
+	return result;
+}
+
+/// Converts bool, char, char*, std::string, std::pair and all numeric types to std::string. Also
+/// supports user defined types that have the operator<< overloaded for std::ostream. 
+/// Specialization for std::pair with extra option that allows to define a delimiter between the
+/// two items of the std::pair.
+/// @param[in] value Any type that can be converted to std::string.
+/// @param[in] delimiter A delimiter that will be used between the pair.
+/// @return An std::string.
+template<typename T1, typename T2>
+[[nodiscard]]
+inline std::string to_string(const std::pair<T1, T2>& value, const std::string& delimiter = ", ")
 {
 	// convert the first item of the pair into a string
 	std::string first_part = mtl::string::to_string(value.first);
@@ -779,186 +2497,947 @@ inline std::string to_string(const std::pair<T1, T2>& value, const std::string&
 	// create a string to add the two parts together
 	std::string result;
 
-	result.reserve(first_part.size() + second_part.size() + delimiter.size());
+	result.reserve(first_part.size() + second_part.size() + delimiter.size());
+
+	// add all the parts together with a delimiter in between them
+	result += first_part;
+	result += delimiter;
+	result += second_part;
+	return result;
+}
+
+
+namespace detail
+{
+
+// The maximum number of characters an integer needs when converted to string, all the digits
+// plus one for the sign.
+template<typename Type>
+constexpr size_t max_number_size_int = 
+static_cast<size_t>(std::numeric_limits<Type>::digits10) + 2;
+
+// The maximum number of characters a floating point number needs when converted to string with
+// the shortest representation. In exponent notation that is the digits, the sign, the decimal
+// point, the exponent character, the exponent sign and up to 4 exponent digits. In fixed notation
+// there are at most 16 digits before the decimal point plus the sign. A margin is added so a
+// different version of fmt that formats slightly differently still fits.
+template<typename Type>
+constexpr size_t max_number_size_float = 
+std::max(static_cast<size_t>(std::numeric_limits<Type>::max_digits10) + 8, size_t(17)) + 8;
+
+// Append an integer to the end of an std::string or an mtl::string::builder without creating a
+// temporary std::string.
+template<typename Output, typename Type>
+inline std::enable_if_t<mtl::is_int_v<Type>, void>
+append_number(Output& result, const Type value)
+{
+	// fmt::format_int formats the number in a buffer it keeps on the stack
+	const fmt::format_int formatted(value);
+	result.append(formatted.data(), formatted.size());
+}
+
+// Append a floating point number to the end of an std::string or an mtl::string::builder without
+// creating a temporary std::string.
+template<typename Output, typename Type>
+inline std::enable_if_t<mtl::is_float_v<Type>, void>
+append_number(Output& result, const Type value)
+{
+	// format the number in a buffer on the stack the same way fmt::to_string does, but without
+	// allocating, then append it
+	char buffer[max_number_size_float<Type>];
+	const auto formatted = fmt::format_to_n(buffer, sizeof(buffer), "{}", value);
+	// the output is truncated if it doesn't fit so in that case format it again without a limit
+	if (formatted.size > sizeof(buffer))
+	{
+		result.append(fmt::to_string(value));
+		return;
+	}
+	result.append(buffer, formatted.size);
+}
+
+// Append any type that mtl::string::to_string accepts to the end of an std::string or an 
+// mtl::string::builder. Numbers, std::string and char are appended directly while everything else
+// is converted with mtl::string::to_string.
+template<typename Output, typename Type>
+inline void append_to_string(Output& result, const Type& value)
+{
+	if constexpr (mtl::is_number_v<Type>)
+	{
+		append_number(result, value);
+	}
+	else if constexpr (std::is_same_v<std::remove_cv_t<Type>, std::string>)
+	{
+		result.append(value.data(), value.size());
+	}
+	else if constexpr (std::is_same_v<std::remove_cv_t<Type>, char>)
+	{
+		result.push_back(value);
+	}
+	else
+	{
+		const std::string converted = mtl::string::to_string(value);
+		result.append(converted.data(), converted.size());
+	}
+}
+
+} // namespace detail end
+
+
+// ===============================================================================================
+// ARENA - Memory arena that hands out memory from large blocks and frees it all at once.
+// ===============================================================================================
+
+/// A monotonic memory arena for characters. It hands out memory from large blocks and never frees
+/// individual allocations, all the memory is freed at once when the arena is destroyed. One arena
+/// can be shared by many mtl::string::builder so building many strings takes very few 
+/// allocations. The arena must outlive everything that uses memory from it.
+class arena
+{
+	// the blocks of memory, the last block is the one memory is handed out from
+	std::vector<std::unique_ptr<char[]>> blocks;
+	// the size of the blocks the arena allocates
+	size_t block_size = 64 * 1024;
+	// the size of the last block
+	size_t last_block_size = 0;
+	// the number of characters already handed out from the last block
+	size_t last_block_used = 0;
+
+public:
+
+	/// Default constructor. The arena allocates blocks of 64 KiB.
+	arena() = default;
+
+	/// Creates an arena that allocates blocks of the given size. Throws std::invalid_argument if
+	/// the block size is 0.
+	/// @param[in] size The size in bytes of each block.
+	explicit arena(const size_t size) : block_size(size)
+	{
+		if (block_size == 0)
+		{
+			throw std::invalid_argument("The block size of the arena can't be 0.");
+		}
+	}
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+
+	// ============================================================================================
+	// ALLOCATE         - Returns memory for the given number of characters.
+	// ============================================================================================
+
+	/// Returns memory for the given number of characters. The memory stays valid until the arena
+	/// is reset or destroyed. Requests larger than the block size get a block of their own.
+	/// @param[in] size The number of characters.
+	/// @return A pointer to the start of the memory.
+	[[nodiscard]]
+	char* allocate(const size_t size)
+	{
+		// a new arena has no block to hand out memory from, even for 0 characters
+		if (blocks.empty() || size > last_block_size - last_block_used)
+		{
+			size_t new_block_size = block_size;
+			if (size > new_block_size)
+			{
+				new_block_size = size;
+			}
+			// the memory is not initialized as it will be overwritten anyway
+			blocks.emplace_back(new char[new_block_size]);
+			last_block_size = new_block_size;
+			last_block_used = 0;
+		}
+
+		char* memory = blocks.back().get() + last_block_used;
+		last_block_used += size;
+		return memory;
+	}
+
+
+	// ============================================================================================
+	// RESET            - Frees all allocations at once.
+	// ============================================================================================
+
+	/// Makes all the memory of the arena available again, invalidating all memory handed out so
+	/// far. The last block is kept so the arena can be reused without allocating.
+	void reset() noexcept
+	{
+		if (blocks.empty()) { return; }
+
+		// resizing to a smaller size never allocates
+		std::swap(blocks.front(), blocks.back());
+		blocks.resize(1);
+		last_block_used = 0;
+	}
+
+
+	// ============================================================================================
+	// BLOCK_COUNT      - Returns the number of blocks.
+	// ============================================================================================
+
+	/// Returns the number of blocks the arena currently has.
+	/// @return The number of blocks.
+	[[nodiscard]]
+	size_t block_count() const noexcept { return blocks.size(); }
+};
+
+
+
+// ===============================================================================================
+// BUILDER - Builds an std::string piece by piece with as few allocations as possible.
+// ===============================================================================================
+
+/// Builds an std::string piece by piece. The first characters are stored inside the builder 
+/// itself so short strings are built without allocating. After that the storage grows 
+/// geometrically on the heap or, if one is given, in an mtl::string::arena. Numbers are appended
+/// without creating temporary strings. When done use release to get the result as an std::string.
+class builder
+{
+	// the number of characters stored inside the builder before it has to allocate
+	static constexpr size_t inline_size = 256;
+
+	// storage for the first characters
+	char inline_data[inline_size];
+	// the start of the storage currently in use, the inline storage, the heap or the arena
+	char* storage = inline_data;
+	// the number of characters in the storage
+	size_t length = 0;
+	// the number of characters that fit in the storage
+	size_t storage_size = inline_size;
+	// storage used when the inline storage runs out and there is no arena
+	std::string heap;
+	// if the storage in use is the heap
+	bool on_heap = false;
+	// the optional arena to use when the inline storage runs out
+	mtl::string::arena* memory = nullptr;
+
+	// Grows the storage geometrically so it fits at least the requested number of characters.
+	void grow(const size_t requested)
+	{
+		size_t new_size = storage_size * 2;
+		if (new_size < requested)
+		{
+			new_size = requested;
+		}
+
+		if (memory != nullptr)
+		{
+			char* new_storage = memory->allocate(new_size);
+			std::memcpy(new_storage, storage, length);
+			storage = new_storage;
+		}
+		else
+		{
+			// the heap std::string is always kept at the size of the storage so its characters
+			// can be written directly, resizing it keeps the characters it already has
+			heap.resize(new_size);
+			if (on_heap == false)
+			{
+				std::memcpy(heap.data(), storage, length);
+				on_heap = true;
+			}
+			storage = heap.data();
+		}
+		storage_size = new_size;
+	}
+
+public:
+
+	/// Default constructor. When the inline storage runs out the builder allocates on the heap.
+	builder() = default;
+
+	/// Creates a builder that uses the arena when the inline storage runs out. The arena must
+	/// outlive the builder.
+	/// @param[in] memory_arena The mtl::string::arena to use for storage.
+	explicit builder(mtl::string::arena& memory_arena) : memory(&memory_arena) {}
+
+	builder(const builder&) = delete;
+	builder& operator=(const builder&) = delete;
+
+
+	// ============================================================================================
+	// SIZE             - Returns the number of characters.
+	// ============================================================================================
+
+	/// Returns the number of characters in the builder.
+	/// @return The number of characters.
+	[[nodiscard]]
+	size_t size() const noexcept { return length; }
+
+
+	// ============================================================================================
+	// EMPTY            - Returns if there are no characters.
+	// ============================================================================================
+
+	/// Returns if there are no characters in the builder.
+	/// @return If the builder is empty.
+	[[nodiscard]]
+	bool empty() const noexcept { return length == 0; }
+
+
+	// ============================================================================================
+	// CAPACITY         - Returns the number of characters that fit without growing.
+	// ============================================================================================
+
+	/// Returns the number of characters the builder can hold before it has to allocate.
+	/// @return The number of characters that fit in the current storage.
+	[[nodiscard]]
+	size_t capacity() const noexcept { return storage_size; }
+
+
+	// ============================================================================================
+	// DATA             - Returns a pointer to the characters.
+	// ============================================================================================
+
+	/// Returns a pointer to the characters of the builder. They are not null terminated.
+	/// @return A pointer to the characters.
+	[[nodiscard]]
+	const char* data() const noexcept { return storage; }
+
+
+	// ============================================================================================
+	// VIEW             - Returns an std::string_view of the characters.
+	// ============================================================================================
+
+	/// Returns an std::string_view of the characters of the builder. It is invalidated when
+	/// characters are appended.
+	/// @return An std::string_view of the characters.
+	[[nodiscard]]
+	std::string_view view() const noexcept { return std::string_view(storage, length); }
+
+
+	// ============================================================================================
+	// RESERVE          - Reserves space for the given number of characters.
+	// ============================================================================================
+
+	/// Makes sure the builder can hold at least the given number of characters without having
+	/// to allocate again.
+	/// @param[in] size The number of characters.
+	void reserve(const size_t size)
+	{
+		if (size > storage_size)
+		{
+			grow(size);
+		}
+	}
+
+
+	// ============================================================================================
+	// CLEAR            - Removes all characters.
+	// ============================================================================================
+
+	/// Removes all characters but keeps the storage so it can be reused.
+	void clear() noexcept { length = 0; }
+
+
+	// ============================================================================================
+	// APPEND           - Appends characters, strings, booleans or numbers.
+	// ============================================================================================
+
+	/// Appends the given number of characters.
+	/// @param[in] value A pointer to the characters.
+	/// @param[in] size The number of characters.
+	/// @return A reference to the builder.
+	builder& append(const char* value, const size_t size)
+	{
+		if (size == 0) { return *this; }
+		if (size > storage_size - length)
+		{
+			grow(length + size);
+		}
+		std::memcpy(storage + length, value, size);
+		length += size;
+		return *this;
+	}
+
+	/// Appends an std::string_view.
+	/// @param[in] value The characters to append.
+	/// @return A reference to the builder.
+	builder& append(std::string_view value) { return append(value.data(), value.size()); }
+
+	/// Appends a const char*. Throws std::logic_error if the const char* is nullptr.
+	/// @param[in] value The characters to append.
+	/// @return A reference to the builder.
+	builder& append(const char* value) { return append(mtl::detail::to_string_view(value)); }
+
+	/// Appends a character.
+	/// @param[in] value The character to append.
+	/// @return A reference to the builder.
+	builder& append(const char value)
+	{
+		if (length == storage_size)
+		{
+			grow(length + 1);
+		}
+		storage[length] = value;
+		++length;
+		return *this;
+	}
+
+	/// Appends a character the given number of times.
+	/// @param[in] times The number of times to append the character.
+	/// @param[in] value The character to append.
+	/// @return A reference to the builder.
+	builder& append(const size_t times, const char value)
+	{
+		if (times > storage_size - length)
+		{
+			grow(length + times);
+		}
+		std::fill(storage + length, storage + length + times, value);
+		length += times;
+		return *this;
+	}
+
+	/// Appends a bool as true or false.
+	/// @param[in] value The bool to append.
+	/// @return A reference to the builder.
+	builder& append(const bool value)
+	{
+		if (value)
+		{
+			return append(std::string_view("true"));
+		}
+		return append(std::string_view("false"));
+	}
+
+	/// Appends an integer or a floating point number without creating a temporary std::string.
+	/// @param[in] value The number to append.
+	/// @return A reference to the builder.
+	template<typename Type>
+	std::enable_if_t<mtl::is_number_v<Type>, builder&> append(const Type value)
+	{
+		mtl::string::detail::append_number(*this, value);
+		return *this;
+	}
+
+
+	// ============================================================================================
+	// PUSH_BACK        - Appends a single character.
+	// ============================================================================================
+
+	/// Appends a character, the same as append for a character.
+	/// @param[in] value The character to append.
+	void push_back(const char value) { append(value); }
+
+
+	// ============================================================================================
+	// RELEASE          - Returns the characters as an std::string.
+	// ============================================================================================
+
+	/// Returns all the characters of the builder as an std::string and leaves the builder empty.
+	/// If the builder stores the characters on the heap they are moved to the std::string 
+	/// without copying them.
+	/// @return An std::string with all the characters.
+	[[nodiscard]]
+	std::string release()
+	{
+		std::string result;
+		if (on_heap)
+		{
+			heap.resize(length);
+			result.swap(heap);
+		}
+		else
+		{
+			result.assign(storage, length);
+		}
+
+		// go back to the inline storage
+		storage = inline_data;
+		length = 0;
+		storage_size = inline_size;
+		on_heap = false;
+		return result;
+	}
+
+	/// Writes the characters of the builder to an output stream.
+	/// @param[in, out] stream The output stream.
+	/// @param[in] value The mtl::string::builder to write.
+	/// @return The output stream.
+	friend std::ostream& operator<<(std::ostream& stream, const builder& value)
+	{
+		stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+		return stream;
+	}
+};
+
+
+
+// ===============================================================================================
+// JOIN_ALL - Join all items from a range (first, last) and return an std::string.
+// ===============================================================================================
+
+/// Join all items of a range from first to last with a delimiter. Allows you to specify the 
+/// output string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the result will be placed.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline std::enable_if_t
+<std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>, std::string>,
+void>
+join_all(Iter first, Iter last, std::string& result, const std::string& delimiter)
+{
+	// if there is nothing to join leave the function
+	if (first == last) { return; } // excluding live from gcovr code coverage, GCOVR_EXCL_LINE
+
+	// the size of the delimiter
+	const size_t delim_size = delimiter.size();
+
+	// count total size of all strings in the container plus the delimiter size
+	size_t total_size = 0;
+	for (auto it = first; it != last; ++it)
+	{
+		total_size += it->size() + delim_size;
+	}
+
+	result.reserve(total_size);
+
+	// join the string with a delimiter
+	if (delim_size > 0)
+	{
+		for (auto it = first; it != last; ++it)
+		{
+			// GCOVR_EXCL_START
+			result += *it;
+			result += delimiter;
+			// GCOVR_EXCL_STOP
+		}
+
+		// remove as many characters as the delimiter's size because we added one unwanted
+		// delimiter at the end
+		result.resize(result.size() - delimiter.size());
+	}
+	// join the string without adding the delimiter
+	else
+	{
+		for (auto it = first; it != last; ++it)
+		{
+			result += *it; // GCOVR_EXCL_LINE
+		}
+	}
+}
+
+
+namespace detail
+{
+
+// Elements are joined directly to the result until the result reaches this size in bytes, after
+// that they are joined to the blocks of a scratch arena.
+constexpr size_t join_block_min_size = 1024;
+
+// The largest size in bytes of a block of the scratch arena.
+constexpr size_t join_block_max_size = 1024 * 1024;
+
+// Numbers, characters and booleans never take more than this many bytes when converted to
+// string, so when this many bytes, plus the size of the delimiter, are left in the current block
+// they can be appended without making the block grow.
+constexpr size_t join_block_margin = 64;
+
+// Returns if elements of the type always fit in join_block_margin when converted to string.
+template<typename Type>
+constexpr bool join_fits_margin_v = mtl::is_number_v<Type> || mtl::is_char_v<Type> ||
+									std::is_same_v<Type, bool>;
+
+// Joins all items of a range from first to last with a delimiter in two passes. The first pass
+// converts the elements to string in blocks of a scratch arena, each block twice the size of the
+// previous, that never grow so the characters are never moved. Elements that can be longer than
+// the margin are converted first, so their size is known and a block large enough for them is
+// started before they are appended. The second pass copies all the blocks to the result that
+// grows only once to the exact size. Small ranges never use the arena and are joined directly to
+// the result.
+template<typename Iter>
+inline void join_all_arena(Iter first, Iter last, std::string& result, 
+						   const std::string& delimiter)
+{
+	using value_type = std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>;
+
+	// the blocks of the arena, the first element is joined to the result itself
+	std::vector<std::string> blocks;
+	std::string* output = &result;
+	const size_t delim_size = delimiter.size();
+
+	// when the current output doesn't have space for the given number of bytes start a new block
+	// instead of letting the output grow and move all of its characters
+	auto make_space = [&blocks, &output](const size_t needed)
+	{
+		if ((output->size() >= join_block_min_size) &&
+			(output->capacity() - output->size() < needed))
+		{
+			size_t block_size = join_block_min_size;
+			if (blocks.empty() == false)
+			{
+				block_size = std::min(blocks.back().capacity() * 2, join_block_max_size);
+			}
+			blocks.emplace_back();
+			blocks.back().reserve(std::max(block_size, needed));
+			output = &blocks.back();
+		}
+	};
+
+	bool first_element = true;
+	for (; first != last; ++first)
+	{
+		if constexpr (join_fits_margin_v<value_type>)
+		{
+			make_space(delim_size + join_block_margin);
+			if (first_element == false) { *output += delimiter; }
+			// convert the element to string and add it
+			mtl::string::detail::append_to_string(*output, *first);
+		}
+		else
+		{
+			// find the size of the element before it is added, elements that can't be viewed as
+			// a string are converted to one
+			std::string converted;
+			std::string_view text;
+			if constexpr (std::is_same_v<std::decay_t<value_type>, const char*> ||
+						  std::is_same_v<std::decay_t<value_type>, char*>)
+			{
+				text = mtl::detail::to_string_view(*first);
+			}
+			else if constexpr (std::is_convertible_v<const value_type&, std::string_view>)
+			{
+				text = *first;
+			}
+			else
+			{
+				converted = mtl::string::to_string(*first);
+				text = converted;
+			}
+
+			make_space(delim_size + text.size());
+			if (first_element == false) { *output += delimiter; }
+			output->append(text.data(), text.size());
+		}
+		first_element = false;
+	}
+
+	// if everything fit in the result there is nothing left to do
+	if (blocks.empty()) { return; }
+
+	// count the exact size of the result so it grows only once
+	size_t total_size = result.size();
+	for (const auto& block : blocks)
+	{
+		total_size += block.size();
+	}
+	result.reserve(total_size);
+
+	for (const auto& block : blocks)
+	{
+		result += block;
+	}
+}
+
+} // namespace detail end
+
+
+/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
+/// string. Elements that are not std::string are converted to string into a scratch arena first, 
+/// so the result only grows once to its exact size.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the result will be placed.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline std::enable_if_t
+<!std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>, std::string>,
+void>
+join_all(Iter first, Iter last, std::string& result, const std::string& delimiter)
+{
+	// if there is nothing to join leave the function
+	if (first == last) { return; } // excluding live from gcovr code coverage, GCOVR_EXCL_LINE
+
+	mtl::string::detail::join_all_arena(first, last, result, delimiter);
+}
+
+
+/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
+/// string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the result will be placed.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline void join_all(Iter first, Iter last, std::string& result, const char delimiter)
+{
+	// GCOVR_EXCL_START
+	mtl::string::join_all(first, last, result, mtl::string::to_string(delimiter));
+	// GCOVR_EXCL_STOP
+}
+
+
+/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
+/// string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result Where the result will be placed.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline void join_all(Iter first, Iter last, std::string& result, const char* delimiter)
+{
+	mtl::string::join_all(first, last, result, mtl::string::to_string(delimiter));
+}
+
+
+/// Join all items of a range from first to last with a delimiter to the end of an 
+/// mtl::string::builder.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result An mtl::string::builder where the result will be appended.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline void join_all(Iter first, Iter last, mtl::string::builder& result, 
+					 std::string_view delimiter)
+{
+	// if there is nothing to join leave the function
+	if (first == last) { return; }
+
+	mtl::string::detail::append_to_string(result, *first);
+	for (++first; first != last; ++first)
+	{
+		result.append(delimiter);
+		mtl::string::detail::append_to_string(result, *first);
+	}
+}
+
+/// Join all items of a range from first to last with a delimiter to the end of an 
+/// mtl::string::builder.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result An mtl::string::builder where the result will be appended.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline void join_all(Iter first, Iter last, mtl::string::builder& result, const char delimiter)
+{
+	mtl::string::join_all(first, last, result, std::string_view(&delimiter, 1));
+}
+
+/// Join all items of a range from first to last with a delimiter to the end of an 
+/// mtl::string::builder.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[out] result An mtl::string::builder where the result will be appended.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+template<typename Iter>
+inline void join_all(Iter first, Iter last, mtl::string::builder& result, const char* delimiter)
+{
+	mtl::string::join_all(first, last, result, mtl::detail::to_string_view(delimiter));
+}
+
+
+/// Join all items of a range from first to last with optional delimiter and return an std::string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+/// @return An std::string with all the elements joined together.
+template<typename Iter>
+[[nodiscard]]
+inline std::string join_all(Iter first, Iter last, const std::string& delimiter = "")
+{
+	std::string result;
+	// use the mtl::string::join_all version where you select the container
+	mtl::string::join_all(first, last, result, delimiter);
+	return result;
+}
+
+/// Join all items of a range from first to last with a delimiter and return an std::string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+/// @return An std::string with all the elements joined together.
+template<typename Iter>
+[[nodiscard]]
+inline std::string join_all(Iter first, Iter last, const char delimiter)
+{
+	return mtl::string::join_all(first, last, mtl::string::to_string(delimiter));
+}
+
+/// Join all items of a range from first to last with a delimiter and return an std::string.
+/// @param[in] first Iterator to the start of the range.
+/// @param[in] last Iterator to the end of the range.
+/// @param[in] delimiter Delimiter to use when joining the elements.
+/// @return An std::string with all the elements joined together.
+template<typename Iter>
+[[nodiscard]]
+inline std::string join_all(Iter first, Iter last, const char* delimiter)
+{
+	return mtl::string::join_all(first, last, mtl::string::to_string(delimiter));
+}
+
+
 
-	// add all the parts together with a delimiter in between them
-	result += first_part;
-	result += delimiter;
-	result += second_part;
-	return result;
-}
 
 
 // ===============================================================================================
-// JOIN_ALL - Join all items from a range (first, last) and return an std::string.
+// JOIN_ALL_PAR - Join all items from a range (first, last) using multiple threads.
 // ===============================================================================================
 
-/// Join all items of a range from first to last with a delimiter. Allows you to specify the 
-/// output string.
+namespace detail
+{
+
+// Ranges with fewer elements than this are always joined serially, as the cost of starting
+// threads is larger than the time it takes to join them.
+constexpr size_t parallel_join_threshold = 64 * 1024;
+
+// The smallest number of elements of each chunk of the range that a single thread joins.
+constexpr size_t parallel_join_min_chunk = 16 * 1024;
+
+} // namespace detail end
+
+
+/// Join all items of a range from first to last with a delimiter using multiple threads. Allows
+/// you to specify the output string. The range is split into chunks, each thread joins a chunk 
+/// and then all chunks are copied to the result that grows only once to the exact size. Small 
+/// ranges are joined serially the same as mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[out] result Where the result will be placed.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 template<typename Iter>
-inline std::enable_if_t
-<std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>, std::string>,
-void>
-join_all(Iter first, Iter last, std::string& result, const std::string& delimiter)
+inline void join_all_par(Iter first, Iter last, std::string& result, 
+						 const std::string& delimiter, const size_t threads = 0)
 {
-	// if there is nothing to join leave the function
-	if (first == last) { return; } // excluding live from gcovr code coverage, GCOVR_EXCL_LINE
-
-	// the size of the delimiter
-	const size_t delim_size = delimiter.size();
+	const size_t elements = static_cast<size_t>(std::distance(first, last));
 
-	// count total size of all strings in the container plus the delimiter size
-	size_t total_size = 0;
-	for (auto it = first; it != last; ++it)
+	// never use more chunks than the number of elements allows so every thread has enough work
+	size_t chunks = mtl::detail::parallel_thread_count(threads);
+	const size_t max_chunks = elements / mtl::string::detail::parallel_join_min_chunk;
+	if (chunks > max_chunks)
 	{
-		total_size += it->size() + delim_size;
+		chunks = max_chunks;
 	}
 
-	result.reserve(total_size);
-
-	// join the string with a delimiter
-	if (delim_size > 0)
+	// for small ranges joining serially is faster than starting threads
+	if ((elements < mtl::string::detail::parallel_join_threshold) || (chunks < 2))
 	{
-		for (auto it = first; it != last; ++it)
-		{
-			// GCOVR_EXCL_START
-			result += *it;
-			result += delimiter;
-			// GCOVR_EXCL_STOP
-		}
-
-		// remove as many characters as the delimiter's size because we added one unwanted
-		// delimiter at the end
-		result.resize(result.size() - delimiter.size());
+		mtl::string::join_all(first, last, result, delimiter);
+		return;
 	}
-	// join the string without adding the delimiter
-	else
+
+	// find where each chunk starts on this thread with a single walk over the range, so threads
+	// don't have to walk from the start of the range when the iterators aren't random access, the
+	// last chunk also takes the elements left over from the division
+	std::vector<Iter> boundaries;
+	boundaries.reserve(chunks + 1);
+	boundaries.push_back(first);
+	for (size_t i = 1; i < chunks; ++i)
 	{
-		for (auto it = first; it != last; ++it)
-		{
-			result += *it; // GCOVR_EXCL_LINE
-		}
+		boundaries.push_back(std::next(boundaries.back(),
+									   static_cast<std::ptrdiff_t>(elements / chunks)));
 	}
-}
-
-
-/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
-/// string.
-/// @param[in] first Iterator to the start of the range.
-/// @param[in] last Iterator to the end of the range.
-/// @param[out] result Where the result will be placed.
-/// @param[in] delimiter Delimiter to use when joining the elements.
-template<typename Iter>
-inline std::enable_if_t
-<!std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>, std::string>,
-void>
-join_all(Iter first, Iter last, std::string& result, const std::string& delimiter)
-{
-	// if there is nothing to join leave the function
-	if (first == last) { return; } // excluding live from gcovr code coverage, GCOVR_EXCL_LINE
-
-	// the size of the delimiter
-	const size_t delim_size = delimiter.size();
+	boundaries.push_back(last);
 
-	// GCOVR_EXCL_START
-	// join the string with a delimiter
-	if (delim_size > 0)
+	// each thread joins its own chunk of the range to its own std::string
+	std::vector<std::string> parts(chunks);
+	mtl::detail::run_parallel(chunks, [&boundaries, &parts, &delimiter](const size_t index)
 	{
-		for (auto it = first; it != last; ++it)
-		{
-			
-			// convert the element to string and add it
-			result += mtl::string::to_string(*it); 
-			result += delimiter;
-			
-		}
+		mtl::string::join_all(boundaries[index], boundaries[index + 1], parts[index], delimiter);
+	});
 
-		// remove as many characters as the delimiter's size because we added one unwanted
-		// delimiter at the end
-		result.resize(result.size() - delimiter.size()); 
+	// count the exact size of the result so it grows only once
+	size_t total_size = result.size() + (delimiter.size() * (chunks - 1));
+	for (const auto& part : parts)
+	{
+		total_size += part.size();
 	}
-	// join the string without adding the delimiter
-	else
+	result.reserve(total_size);
+
+	// place all chunks to the result in the order they appear in the range
+	result += parts[0];
+	for (size_t i = 1; i < chunks; ++i)
 	{
-		for (auto it = first; it != last; ++it)
-		{
-			result += mtl::string::to_string(*it); 
-		}
+		result += delimiter;
+		result += parts[i];
 	}
-	// GCOVR_EXCL_STOP
-	
 }
 
-
-/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
-/// string.
+/// Join all items of a range from first to last with a delimiter using multiple threads. Allows
+/// you to specify the output string. The range is split into chunks, each thread joins a chunk 
+/// and then all chunks are copied to the result that grows only once to the exact size. Small 
+/// ranges are joined serially the same as mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[out] result Where the result will be placed.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 template<typename Iter>
-inline void join_all(Iter first, Iter last, std::string& result, const char delimiter)
+inline void join_all_par(Iter first, Iter last, std::string& result, const char delimiter,
+						 const size_t threads = 0)
 {
-	// GCOVR_EXCL_START
-	mtl::string::join_all(first, last, result, mtl::string::to_string(delimiter));
-	// GCOVR_EXCL_STOP
+	mtl::string::join_all_par(first, last, result, mtl::string::to_string(delimiter), threads);
 }
 
-
-/// Join all items of a range from first to last with a delimiter. Allows you to specify the output
-/// string.
+/// Join all items of a range from first to last with a delimiter using multiple threads. Allows
+/// you to specify the output string. The range is split into chunks, each thread joins a chunk 
+/// and then all chunks are copied to the result that grows only once to the exact size. Small 
+/// ranges are joined serially the same as mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[out] result Where the result will be placed.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 template<typename Iter>
-inline void join_all(Iter first, Iter last, std::string& result, const char* delimiter)
+inline void join_all_par(Iter first, Iter last, std::string& result, const char* delimiter,
+						 const size_t threads = 0)
 {
-	mtl::string::join_all(first, last, result, mtl::string::to_string(delimiter));
+	mtl::string::join_all_par(first, last, result, mtl::string::to_string(delimiter), threads);
 }
 
-
-/// Join all items of a range from first to last with optional delimiter and return an std::string.
+/// Join all items of a range from first to last with optional delimiter using multiple threads 
+/// and return an std::string. The range is split into chunks, each thread joins a chunk and then
+/// all chunks are copied to the result. Small ranges are joined serially the same as
+/// mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 /// @return An std::string with all the elements joined together.
 template<typename Iter>
 [[nodiscard]]
-inline std::string join_all(Iter first, Iter last, const std::string& delimiter = "")
+inline std::string join_all_par(Iter first, Iter last, const std::string& delimiter = "",
+								const size_t threads = 0)
 {
 	std::string result;
-	// use the mtl::string::join_all version where you select the container
-	mtl::string::join_all(first, last, result, delimiter);
+	mtl::string::join_all_par(first, last, result, delimiter, threads);
 	return result;
 }
 
-/// Join all items of a range from first to last with a delimiter and return an std::string.
+/// Join all items of a range from first to last with a delimiter using multiple threads and 
+/// return an std::string. The range is split into chunks, each thread joins a chunk and then all
+/// chunks are copied to the result. Small ranges are joined serially the same as
+/// mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 /// @return An std::string with all the elements joined together.
 template<typename Iter>
 [[nodiscard]]
-inline std::string join_all(Iter first, Iter last, const char delimiter)
+inline std::string join_all_par(Iter first, Iter last, const char delimiter, 
+								const size_t threads = 0)
 {
-	return mtl::string::join_all(first, last, mtl::string::to_string(delimiter));
+	return mtl::string::join_all_par(first, last, mtl::string::to_string(delimiter), threads);
 }
 
-/// Join all items of a range from first to last with a delimiter and return an std::string.
+/// Join all items of a range from first to last with a delimiter using multiple threads and 
+/// return an std::string. The range is split into chunks, each thread joins a chunk and then all
+/// chunks are copied to the result. Small ranges are joined serially the same as
+/// mtl::string::join_all.
 /// @param[in] first Iterator to the start of the range.
 /// @param[in] last Iterator to the end of the range.
 /// @param[in] delimiter Delimiter to use when joining the elements.
+/// @param[in] threads The maximum number of threads to use, 0 to use the hardware threads.
 /// @return An std::string with all the elements joined together.
 template<typename Iter>
 [[nodiscard]]
-inline std::string join_all(Iter first, Iter last, const char* delimiter)
+inline std::string join_all_par(Iter first, Iter last, const char* delimiter, 
+								const size_t threads = 0)
 {
-	return mtl::string::join_all(first, last, mtl::string::to_string(delimiter));
+	return mtl::string::join_all_par(first, last, mtl::string::to_string(delimiter), threads);
 }
 
 
@@ -975,15 +3454,15 @@ namespace detail
 {
 
 // Actual implementation for variadic template join.
-template<typename Type>
-inline void join_impl(std::string& value, const Type& type)
+template<typename Output, typename Type>
+inline void join_impl(Output& value, const Type& type)
 {
-	value += mtl::string::to_string(type); // GCOVR_EXCL_LINE
+	mtl::string::detail::append_to_string(value, type); // GCOVR_EXCL_LINE
 }
 
 // Actual implementation for variadic template join.
-template<typename Type, typename... Args>
-inline void join_impl(std::string& value, const Type& type, Args&&... args)
+template<typename Output, typename Type, typename... Args>
+inline void join_impl(Output& value, const Type& type, Args&&... args)
 {
 	join_impl(value, type);
 	join_impl(value, std::forward<Args>(args)...);
@@ -1021,11 +3500,23 @@ inline void count_size_impl(size_t& size, const bool type)
 	
 }
 
-// Count size for int. This is intentionally empty and also declared so integer are not implicitly
-// converted to chars and to stop warnings about integer conversion.
-inline void count_size_impl(size_t&, const int)
+// Count size for integers. Integers are counted with the maximum number of characters they can
+// take so the std::string never has to grow while they are appended.
+template<typename Type>
+inline std::enable_if_t<mtl::is_int_v<Type>, void>
+count_size_impl(size_t& size, const Type)
 {
+	size += max_number_size_int<Type>;
+}
 
+// Count size for floating point numbers. Floating point numbers are counted with the maximum
+// number of characters they can take so the std::string never has to grow while they are 
+// appended.
+template<typename Type>
+inline std::enable_if_t<mtl::is_float_v<Type>, void>
+count_size_impl(size_t& size, const Type)
+{
+	size += max_number_size_float<Type>;
 }
 
 // Count size for char.
@@ -1047,7 +3538,8 @@ inline void count_size_impl(size_t& size, const std::pair<Type1, Type2>& type)
 
 // Count size for all non-specialize types. Do not remove.
 template<typename Type>
-inline void count_size_impl(size_t&, const Type&)
+inline std::enable_if_t<!mtl::is_number_v<Type>, void>
+count_size_impl(size_t&, const Type&)
 {
 	// For non-specialized types the count is 0. All modern compilers with high optimization
 	// settings will turn this function into a NOOP.
@@ -1056,8 +3548,8 @@ inline void count_size_impl(size_t&, const Type&)
 
 
 
-// Variadic template that counts the number of characters for std::string, const char*, char and
-// std::pair found in the arguments. All other types are not counted.
+// Variadic template that counts the number of characters for std::string, const char*, char,
+// bool, numbers and std::pair found in the arguments. All other types are not counted.
 template<typename Type, typename... Args>
 inline void count_size_impl(size_t& size, const Type& type, Args&&... args)
 {
@@ -1072,8 +3564,8 @@ template<typename Type, typename... Args>
 inline std::string join_select_impl(const Type& type, Args&&... args)
 {
 	size_t size = 0;
-	// count the number of characters of types that can be counted like std::string, const char* 
-	// and char so we can reserve the std::string's size
+	// count the number of characters of types that can be counted like std::string, const char*,
+	// char and numbers so we can reserve the std::string's size
 	count_size_impl(size, type, args...);
 
 	std::string result;
@@ -1106,6 +3598,23 @@ inline std::string join(const Type& type, Args&&... args)
 	return mtl::string::detail::join_select_impl(type, std::forward<Args>(args)...);
 }
 
+/// Join one or more elements of any type to the end of an mtl::string::builder.
+/// @param[out] result An mtl::string::builder where the items will be appended.
+/// @param[in] args Any number of items to join.
+template<typename... Args>
+inline void join(mtl::string::builder& result, Args&&... args)
+{
+	if constexpr (sizeof...(Args) > 0)
+	{
+		size_t size = result.size();
+		// count the number of characters of types that can be counted like std::string, 
+		// const char*, char and numbers so the builder grows at most once
+		mtl::string::detail::count_size_impl(size, args...);
+		result.reserve(size);
+		mtl::string::detail::join_impl(result, std::forward<Args>(args)...);
+	}
+}
+
 // ===============================================================================================
 // SPLIT - Splits a string into tokens with a given delimiter.
 // ===============================================================================================
@@ -1113,12 +3622,12 @@ inline std::string join(const Type& type, Args&&... args)
 /// Splits a string into tokens with a delimiter. Gives the ability to select the type of container
 /// to be used as output and even allows you to reserve memory for it, if it supports reserve.
 /// The element type of the container has to be std::string.
-/// @param[in] value The std::string to split.
+/// @param[in] value The std::string_view to split.
 /// @param[out] result The container where all the parts will be placed. The element for the
 ///                    container has to be std::string. You can use reserve.
 /// @param[in] delimiter A delimiter that will be used to identify where to split.
 template<typename Container>
-inline void split(const std::string& value, Container& result, const std::string& delimiter)
+inline void split(std::string_view value, Container& result, std::string_view delimiter)
 {
 	// if the input string is empty do nothing and return
 	if (value.empty())
@@ -1139,7 +3648,7 @@ inline void split(const std::string& value, Container& result, const std::string
 	// remember the starting position
 	size_t start = 0;
 	// position of the first match
-	size_t match_pos = value.find(delimiter);
+	size_t match_pos = mtl::detail::find_substring(value, delimiter);
 
 	// keep the position for the last item
 	size_t last_pos = 0;
@@ -1153,91 +3662,411 @@ inline void split(const std::string& value, Container& result, const std::string
 		const std::string_view token(value.data() + start, match_pos - start);
 		mtl::emplace_back(result, token);
 
-		
-		// set the a new starting position
-		start = match_pos + delimiter.size();
-		// find a new position in the input string if there are any matches left
-		match_pos = value.find(delimiter, start);
+		
+		// set the a new starting position
+		start = match_pos + delimiter.size();
+		// find a new position in the input string if there are any matches left
+		match_pos = mtl::detail::find_substring(value, delimiter, start);
+	}
+
+	// how much we added to the container
+	const auto size_difference = result.size() - original_size;
+
+	// if container changed size it means there are tokens in the output
+	if(size_difference > 0)
+	{
+		// add the last item using the last position, the input may not be null terminated so the
+		// size is needed
+		const size_t last_start = last_pos + delimiter.size();
+		const std::string_view token(value.data() + last_start, value.size() - last_start);
+		mtl::emplace_back(result, token);
+	}
+
+
+	// if the container's size didn't change at all then add the entire input string because it
+	// means there are no places that it needs to be split
+	if (size_difference == 0) { mtl::emplace_back(result, value); }
+}
+
+
+/// Splits a string into tokens with a delimiter. Gives the ability to select the type of container
+/// to be used as output and even allows you to reserve memory for it, if it supports reserve.
+/// The element type of the container has to be std::string. All delimiters are found in a single
+/// pass that uses SIMD when it is available.
+/// @param[in] value The std::string_view to split.
+/// @param[out] result The container where all the parts will be placed. The element of the
+///                    container has to be std::string. You can use reserve.
+/// @param[in] delimiter A delimiter that will be used to identify where to split.
+template<typename Container>
+inline void split(std::string_view value, Container& result, const char delimiter)
+{
+	// if the input string is empty do nothing and return
+	if (value.empty())
+	{
+		return;
+	}
+
+	// remember the starting position
+	size_t start = 0;
+
+	// add all tokens to the container except the last one, all delimiters are found in a single
+	// pass that uses SIMD when it is available
+	mtl::detail::for_each_char(value.data(), value.size(), delimiter,
+	[&value, &result, &start](const size_t match_pos)
+	{
+		const std::string_view token(value.data() + start, match_pos - start);
+		mtl::emplace_back(result, token);
+		// set the a new starting position
+		start = match_pos + 1;
+	});
+
+	// add the last token, if there were no delimiters this adds the entire input string
+	const std::string_view token(value.data() + start, value.size() - start);
+	mtl::emplace_back(result, token);
+}
+
+/// Splits a string into tokens with a delimiter. Gives the ability to select the type of container
+/// to be used as output and even allows you to reserve memory for it, if it supports reserve.
+/// The element type of the container has to be std::string.
+/// @param[in] value The std::string_view to split.
+/// @param[out] result The container where all the parts will be placed. The element of the
+///                    container has to be std::string. You can use reserve.
+/// @param[in] delimiter A delimiter that will be used to identify where to split.
+template<typename Container>
+inline void split(std::string_view value, Container& result, const char* delimiter)
+{
+	mtl::string::split(value, result, mtl::detail::to_string_view(delimiter));
+}
+
+
+/// Splits a string into tokens with an optional delimiter.
+/// @param[in] value The std::string_view to split.
+/// @param[in] delimiter An optional delimiter that will be used to identify where to split.
+/// @return An std::vector of std::string that holds all the parts.
+[[nodiscard]]
+inline std::vector<std::string> split(std::string_view value, std::string_view delimiter = " ")
+{
+	std::vector<std::string> result;
+
+	// use the split version where you select the container type to avoid code duplication
+	mtl::string::split(value, result, delimiter);
+
+	return result;
+}
+
+/// Splits a string into tokens with a delimiter.
+/// @param[in] value The std::string_view to split.
+/// @param[in] delimiter A delimiter that will be used to identify where to split.
+/// @return An std::vector of std::string that holds all the parts.
+[[nodiscard]]
+inline std::vector<std::string> split(std::string_view value, const char delimiter)
+{
+	std::vector<std::string> result;
+	mtl::string::split(value, result, delimiter);
+	return result;
+}
+
+/// Splits a string into tokens with a delimiter.
+/// @param[in] value The std::string_view to split.
+/// @param[in] delimiter A delimiter that will be used to identify where to split.
+/// @return An std::vector of std::string that holds all the parts.
+[[nodiscard]]
+inline std::vector<std::string> split(std::string_view value, const char* delimiter)
+{
+	return mtl::string::split(value, mtl::detail::to_string_view(delimiter));
+}
+
+
+
+
+
+// ================================================================================================
+// SPLIT_VIEW       - Lazily splits a string into tokens of std::string_view.
+// ================================================================================================
+
+/// A range that splits a string into tokens with a delimiter lazily. Each token is found only when
+/// the iterator is incremented and it is an std::string_view to the input, so nothing is allocated
+/// and iteration can stop at any point without searching the rest of the input. The tokens are
+/// exactly the same as the ones produced by mtl::string::split. The input and a delimiter of
+/// std::string_view type are not copied, so they have to outlive the split_view and its iterators.
+class split_view
+{
+	// the string to split
+	std::string_view input;
+	// the delimiter when splitting with a string
+	std::string_view delimiter_string;
+	// the delimiter when splitting with a single character
+	char delimiter_char = ' ';
+	// if the delimiter is a single character
+	bool use_char = false;
+
+	// Returns the position of the next delimiter starting from the given position.
+	size_t find_delimiter(const size_t position) const noexcept
+	{
+		if (use_char)
+		{
+			const size_t match_pos = mtl::detail::find_char(input.data() + position,
+															input.size() - position,
+															delimiter_char);
+			if (match_pos == std::string_view::npos) { return match_pos; }
+			return position + match_pos;
+		}
+		return mtl::detail::find_substring(input, delimiter_string, position);
+	}
+
+	// Returns the size of the delimiter.
+	size_t delimiter_size() const noexcept
+	{
+		if (use_char) { return 1; }
+		return delimiter_string.size();
+	}
+
+public:
+
+	/// Forward iterator that finds the next token each time it is incremented.
+	class iterator
+	{
+		// the split_view the iterator belongs to
+		const split_view* parent = nullptr;
+		// the current token
+		std::string_view token;
+		// the position where the current token starts
+		size_t start = 0;
+		// if the current token is the last one
+		bool last = true;
+		// if the iterator is past the last token
+		bool finished = true;
+
+		// Finds the token that starts at the current starting position.
+		void find_token() noexcept
+		{
+			const auto& input = parent->input;
+			// when there is no delimiter the entire input is a single token
+			size_t match_pos = std::string_view::npos;
+			if (parent->delimiter_size() > 0)
+			{
+				match_pos = parent->find_delimiter(start);
+			}
+
+			if (match_pos == std::string_view::npos)
+			{
+				token = input.substr(start);
+				last = true;
+			}
+			else
+			{
+				token = input.substr(start, match_pos - start);
+				last = false;
+			}
+		}
+
+		friend class split_view;
+
+		// Creates an iterator to the first token of the split_view.
+		explicit iterator(const split_view* view) noexcept : parent(view), last(false),
+		finished(false)
+		{
+			find_token();
+		}
+
+	public:
+
+		/// The category of the iterator.
+		using iterator_category = std::forward_iterator_tag;
+		/// The type of each token.
+		using value_type = std::string_view;
+		/// The type of the difference between two iterators.
+		using difference_type = std::ptrdiff_t;
+		/// The type of a pointer to a token.
+		using pointer = const std::string_view*;
+		/// The type of a reference to a token.
+		using reference = const std::string_view&;
+
+		/// Default constructor. Creates an iterator past the last token.
+		iterator() = default;
+
+		/// Returns the current token.
+		/// @return An std::string_view to the current token.
+		reference operator*() const noexcept { return token; }
+
+		/// Returns a pointer to the current token.
+		/// @return A pointer to an std::string_view to the current token.
+		pointer operator->() const noexcept { return &token; }
+
+		/// Finds the next token.
+		/// @return A reference to this iterator.
+		iterator& operator++() noexcept
+		{
+			if (last)
+			{
+				finished = true;
+				token = std::string_view();
+				return *this;
+			}
+			// the next token starts right after the delimiter that ended the current token
+			start = start + token.size() + parent->delimiter_size();
+			find_token();
+			return *this;
+		}
+
+		/// Finds the next token.
+		/// @return A copy of the iterator before it was incremented.
+		iterator operator++(int) noexcept
+		{
+			iterator previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		/// Compares two iterators for equality.
+		/// @param[in] lhs An iterator to compare.
+		/// @param[in] rhs An iterator to compare.
+		/// @return If the iterators point to the same token.
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept
+		{
+			if (lhs.finished || rhs.finished) { return (lhs.finished == rhs.finished); }
+			return (lhs.parent == rhs.parent) && (lhs.start == rhs.start);
+		}
+
+		/// Compares two iterators for inequality.
+		/// @param[in] lhs An iterator to compare.
+		/// @param[in] rhs An iterator to compare.
+		/// @return If the iterators point to different tokens.
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+	/// Iterator type for iterating the tokens.
+	using const_iterator = iterator;
+	/// The type of each token.
+	using value_type = std::string_view;
+
+	/// Creates a range that splits the input with a string delimiter. If the delimiter is empty
+	/// the entire input is a single token.
+	/// @param[in] value The string to split.
+	/// @param[in] delimiter A delimiter that will be used to identify where to split.
+	explicit split_view(std::string_view value, std::string_view delimiter = " ") noexcept :
+	input(value), delimiter_string(delimiter)
+	{
+	}
+
+	/// Creates a range that splits the input with a character delimiter.
+	/// @param[in] value The string to split.
+	/// @param[in] delimiter A delimiter that will be used to identify where to split.
+	split_view(std::string_view value, const char delimiter) noexcept : input(value),
+	delimiter_char(delimiter), use_char(true)
+	{
 	}
 
-	// how much we added to the container
-	const auto size_difference = result.size() - original_size;
 
-	// if container changed size it means there are tokens in the output
-	if(size_difference > 0)
+	// ============================================================================================
+	// BEGIN            - Returns an iterator to the first token.
+	// ============================================================================================
+
+	/// Returns an iterator to the first token. If the input is empty there are no tokens.
+	/// @return An iterator to the first token.
+	[[nodiscard]]
+	iterator begin() const noexcept
 	{
-		// add the last item using the last position
-		const std::string_view token(value.data() + (last_pos + delimiter.size()));
-		mtl::emplace_back(result, token);
+		if (input.empty()) { return iterator(); }
+		return iterator(this);
 	}
 
 
-	// if the container's size didn't change at all then add the entire input string because it
-	// means there are no places that it needs to be split
-	if (size_difference == 0) { mtl::emplace_back(result, value); }
-}
+	// ============================================================================================
+	// END              - Returns an iterator past the last token.
+	// ============================================================================================
 
+	/// Returns an iterator past the last token.
+	/// @return An iterator past the last token.
+	[[nodiscard]]
+	iterator end() const noexcept { return iterator(); }
 
-/// Splits a string into tokens with a delimiter. Gives the ability to select the type of container
-/// to be used as output and even allows you to reserve memory for it, if it supports reserve.
-/// The element type of the container has to be std::string.
-/// @param[in] value The std::string to split.
-/// @param[out] result The container where all the parts will be placed. The element of the
-///                    container has to be std::string. You can use reserve.
-/// @param[in] delimiter A delimiter that will be used to identify where to split.
-template<typename Container>
-inline void split(const std::string& value, Container& result, const char delimiter)
-{
-	mtl::string::split(value, result, mtl::string::to_string(delimiter)); // GCOVR_EXCL_LINE
-}
 
-/// Splits a string into tokens with a delimiter. Gives the ability to select the type of container
-/// to be used as output and even allows you to reserve memory for it, if it supports reserve.
-/// The element type of the container has to be std::string.
-/// @param[in] value The std::string to split.
+	// ============================================================================================
+	// EMPTY            - Returns if there are no tokens.
+	// ============================================================================================
+
+	/// Returns if there are no tokens, that only happens when the input is empty.
+	/// @return If there are no tokens.
+	[[nodiscard]]
+	bool empty() const noexcept { return input.empty(); }
+};
+
+
+
+
+
+// ================================================================================================
+// SPLIT_ANY        - Splits a string into tokens at any of the given delimiters.
+// ================================================================================================
+
+/// Splits a string into tokens at any of the given delimiter characters. For example splitting
+/// with the delimiters " \t\r\n" splits at any whitespace character. The delimiters are placed in
+/// a lookup table once and the input is split in a single pass, no matter how many delimiters
+/// there are. If skip_empty is true the empty tokens, that appear when delimiters are next to each
+/// other or at the start and end of the input, are not added. Gives the ability to select the
+/// type of container to be used as output and even allows you to reserve memory for it, if it
+/// supports reserve. The element type of the container has to be std::string.
+/// @param[in] value The std::string_view to split.
 /// @param[out] result The container where all the parts will be placed. The element of the
 ///                    container has to be std::string. You can use reserve.
-/// @param[in] delimiter A delimiter that will be used to identify where to split.
+/// @param[in] delimiters The characters that will be used to identify where to split.
+/// @param[in] skip_empty An optional boolean to not add empty tokens.
 template<typename Container>
-inline void split(const std::string& value, Container& result, const char* delimiter)
+inline void split_any(std::string_view value, Container& result, std::string_view delimiters,
+					  const bool skip_empty = false)
 {
-	mtl::string::split(value, result, mtl::string::to_string(delimiter));
-}
-
+	// if the input string is empty do nothing and return
+	if (value.empty())
+	{
+		return;
+	}
 
-/// Splits a string into tokens with an optional delimiter.
-/// @param[in] value The std::string to split.
-/// @param[in] delimiter An optional delimiter that will be used to identify where to split.
-/// @return An std::vector of std::string that holds all the parts.
-[[nodiscard]]
-inline std::vector<std::string> split(const std::string& value, const std::string& delimiter = " ")
-{
-	std::vector<std::string> result;
+	const mtl::detail::char_set delimiter_set(delimiters);
 
-	// use the split version where you select the container type to avoid code duplication
-	mtl::string::split(value, result, delimiter);
+	// remember the starting position
+	size_t start = 0;
 
-	return result;
-}
+	// add all tokens to the container except the last one
+	for (size_t i = 0; i < value.size(); ++i)
+	{
+		if (delimiter_set.contains(value[i]))
+		{
+			if ((skip_empty == false) || (i > start))
+			{
+				const std::string_view token(value.data() + start, i - start);
+				mtl::emplace_back(result, token);
+			}
+			// set the a new starting position
+			start = i + 1;
+		}
+	}
 
-/// Splits a string into tokens with a delimiter.
-/// @param[in] value The std::string to split.
-/// @param[in] delimiter A delimiter that will be used to identify where to split.
-/// @return An std::vector of std::string that holds all the parts.
-[[nodiscard]]
-inline std::vector<std::string> split(const std::string& value, const char delimiter)
-{
-	return mtl::string::split(value, mtl::string::to_string(delimiter));
+	// add the last token, if there were no delimiters this adds the entire input string
+	if ((skip_empty == false) || (value.size() > start))
+	{
+		const std::string_view token(value.data() + start, value.size() - start);
+		mtl::emplace_back(result, token);
+	}
 }
 
-/// Splits a string into tokens with a delimiter.
-/// @param[in] value The std::string to split.
-/// @param[in] delimiter A delimiter that will be used to identify where to split.
+/// Splits a string into tokens at any of the given delimiter characters. If skip_empty is true the
+/// empty tokens, that appear when delimiters are next to each other or at the start and end of
+/// the input, are not added.
+/// @param[in] value The std::string_view to split.
+/// @param[in] delimiters The characters that will be used to identify where to split.
+/// @param[in] skip_empty An optional boolean to not add empty tokens.
 /// @return An std::vector of std::string that holds all the parts.
 [[nodiscard]]
-inline std::vector<std::string> split(const std::string& value, const char* delimiter)
+inline std::vector<std::string> split_any(std::string_view value, std::string_view delimiters,
+										  const bool skip_empty = false)
 {
-	return mtl::string::split(value, mtl::string::to_string(delimiter));
+	std::vector<std::string> result;
+	mtl::string::split_any(value, result, delimiters, skip_empty);
+	return result;
 }
 
 
@@ -1253,204 +4082,186 @@ namespace detail
 {
 
 // Replaces all places in the input std::string where a match is found with the replacement 
-// std::string. Version specialized for handling short strings much faster.
-inline void replace_short(std::string& value, const std::string& match, 
-						  const std::string& replacement)
+// std::string. Version specialized for handling short strings much faster. Returns the number of
+// replacements.
+inline size_t replace_short(std::string& value, std::string_view match, 
+							std::string_view replacement)
 {
+	size_t count = 0;
 	size_t pos = 0;
-	while ((pos = value.find(match, pos)) != std::string::npos)
+	while ((pos = mtl::detail::find_substring(value, match, pos)) != std::string::npos)
 	{
 		value.replace(pos, match.size(), replacement);
 		pos += replacement.size();
+		++count;
 	}
+	return count;
 }
 
 
 
-// Replaces all places in the input std::string where a match is found with the replacement 
-// std::string. Version specialized for handling long strings faster but is even more specialized
-// than mtl::string::replace_long to be called only after the stack array is full and we have to
-// start using heap allocations for keeping track of the positions where matches were found.
-inline void replace_long_heap(std::string& value, const std::string& match,
-							  const std::string& replacement,
-							  const std::array<size_t, 20>& found_positions,
-							  const size_t starting_position)
+// Keeps the positions of matches in an array on the stack and only when the array is full it
+// moves them to the heap and keeps growing there, so few matches don't allocate and many matches
+// don't have to be searched for again.
+class match_positions
 {
-	// GCOVR_EXCL_START
-	std::vector<size_t> positions(found_positions.begin(), found_positions.end());
-	// GCOVR_EXCL_STOP
-
-	size_t pos = starting_position;
-	// find all matches and keep their index
-	while ((pos = value.find(match, pos)) != std::string::npos)
-	{
-		positions.emplace_back(pos); // GCOVR_EXCL_LINE
-		// move the position forward enough so we don't match the same thing again
-		pos += match.size();
-	}
+	// the number of positions that fit on the stack
+	static constexpr size_t stack_size = 32;
+	// the positions while they fit on the stack
+	std::array<size_t, stack_size> stack_positions {};
+	// the positions after they no longer fit on the stack
+	std::vector<size_t> heap_positions;
+	// the number of positions
+	size_t count = 0;
 
-	std::string result;
-	size_t difference = 0;
+public:
 
-	// if what we replace is larger than the match then it is easy
-	if (replacement.size() >= match.size())
+	// Adds a position.
+	void push_back(const size_t position)
 	{
-		difference = value.size() + (positions.size() * (replacement.size() - match.size()));
+		if (count < stack_size)
+		{
+			stack_positions[count] = position;
+		}
+		else
+		{
+			// the stack is full so move all positions to the heap
+			if (count == stack_size)
+			{
+				heap_positions.reserve(stack_size * 4);
+				heap_positions.assign(stack_positions.begin(), stack_positions.end());
+			}
+			heap_positions.push_back(position);
+		}
+		++count;
 	}
-	// if what we replace is smaller than the match then we have to convert numbers to a
-	// signed integer type so we can accept negative numbers
-	else
-	{
-		// turn size_t to int64_t
-		int64_t positions_size = static_cast<int64_t>(positions.size());
-		int64_t replacement_size = static_cast<int64_t>(replacement.size());
-		int64_t match_size = static_cast<int64_t>(match.size());
-		// this value will never be negative
-		int64_t diff = positions_size * (match_size - replacement_size);
-		// after this calculation the number can never be negative as the input string size is
-		// always larger as we have checked for this before
-		diff = static_cast<int64_t>(value.size()) - diff;
 
-#ifndef MTL_DISABLE_SOME_ASSERTS
-		MTL_ASSERT_MSG(diff >= 0, 
-		"The number can't be negative. mtl::string::detail::replace_long contains errors.");
-#endif  // MTL_DISABLE_SOME_ASSERTS end
+	// Returns the number of positions.
+	[[nodiscard]]
+	size_t size() const noexcept { return count; }
 
-		// convert to size_t with no problems as this can't be negative
-		difference = static_cast<size_t>(diff);
+	// Returns the position at the given index.
+	[[nodiscard]]
+	size_t operator[](const size_t index) const noexcept
+	{
+		if (count <= stack_size) { return stack_positions[index]; }
+		return heap_positions[index];
 	}
+};
 
-	// resize to avoid unnecessary allocations
-	result.resize(difference); // GCOVR_EXCL_LINE
 
-	// create various iterators
-	const auto beginning = value.begin();
-	auto it_begin = value.begin();
-	auto it_end = value.begin();
-	auto it_output = result.begin();
 
-	for (const auto position : positions)
+// Replaces all places in the input std::string where a match is found with the replacement 
+// std::string, when the replacement isn't larger than the match. The output is never larger than
+// the input so it is written over the input in a single pass, each part between matches is moved
+// back only once and there are no allocations. Returns the number of replacements.
+inline size_t replace_long_shrink(std::string& value, std::string_view match,
+								  std::string_view replacement)
+{
+	size_t count = 0;
+	char* data = value.data();
+	// the position to write the next part to
+	size_t write_pos = 0;
+	// the position of the first character after the last match
+	size_t read_pos = 0;
+	// the output is always behind the position we search from, so the input we haven't searched
+	// yet is never overwritten
+	size_t pos = 0;
+	while ((pos = mtl::detail::find_substring(value, match, pos)) != std::string::npos)
 	{
-		// GCOVR_EXCL_START
-		// copies parts to output string and moves the iterators along
-		it_end = std::next(beginning, static_cast<std::ptrdiff_t>(position));
-		std::copy(it_begin, it_end, it_output);
-		std::advance(it_output, std::distance(it_begin, it_end));
-		std::copy(replacement.begin(), replacement.end(), it_output);
-		std::advance(it_output, static_cast<std::ptrdiff_t>(replacement.size()));
-		it_begin = std::next(it_end, static_cast<std::ptrdiff_t>(match.size()));
-		// GCOVR_EXCL_STOP
+		// move the part before the match, there is nothing to move before the first match
+		const size_t part_size = pos - read_pos;
+		if (write_pos != read_pos)
+		{
+			std::memmove(data + write_pos, data + read_pos, part_size);
+		}
+		write_pos += part_size;
+		std::memcpy(data + write_pos, replacement.data(), replacement.size());
+		write_pos += replacement.size();
+		// move the position forward enough so we don't match the same thing again
+		pos += match.size();
+		read_pos = pos;
+		++count;
 	}
-	// copy from the last match to the end
-	std::copy(it_begin, value.end(), it_output); // GCOVR_EXCL_LINE
 
-	// copy the result to the input string
-	value = result; // GCOVR_EXCL_LINE
+	// if nothing is found leave
+	if (count == 0) { return 0; }
+
+	// move the part after the last match
+	const size_t part_size = value.size() - read_pos;
+	std::memmove(data + write_pos, data + read_pos, part_size);
+	value.resize(write_pos + part_size);
+	return count;
 }
 
 
 
 // Replaces all places in the input std::string where a match is found with the replacement 
-// std::string. Version specialized for handling long strings much faster.
-inline void replace_long(std::string& value, const std::string& match,
-						 const std::string& replacement)
+// std::string, when the replacement is larger than the match. All positions are found first, the
+// input is grown once to its final size and then the parts between matches are moved towards the
+// end starting from the last one, so every part is moved only once and there is no copy of the
+// whole output. Returns the number of replacements.
+inline size_t replace_long_grow(std::string& value, std::string_view match,
+								std::string_view replacement)
 {
-	// if input size is smaller than match then do nothing, this covers the cases where input size
-	// is 0
-	if (value.size() < match.size())
-	{
-		return;
-	}
-
-	// set the maximum size of items for our stack array
-	constexpr size_t max_size = 20;
-	// create an array on the stack to avoid heap allocations, the array will usually be larger 
-	// than the amount of positions found, if the positions fill the array we call an algorithm 
-	// where we use the heap and can track more positions
-	std::array<size_t, max_size> positions {};
-	// this number keeps track of the number of positions found to match
-	size_t num_matches = 0;
+	match_positions positions;
 
 	size_t pos = 0;
 	// find all matches and keep their index
-	while ((pos = value.find(match, pos)) != std::string::npos)
+	while ((pos = mtl::detail::find_substring(value, match, pos)) != std::string::npos)
 	{
-		// if the array can't hold more items start using the heap instead of the stack
-		if (num_matches == max_size)
-		{
-			replace_long_heap(value, match, replacement, positions, pos); // GCOVR_EXCL_LINE
-			return;
-		}
-
-		// store the position where a match was found
-		positions[num_matches] = pos;
-		++num_matches;
+		positions.push_back(pos);
 		// move the position forward enough so we don't match the same thing again
 		pos += match.size();
 	}
 
 	// if nothing is found leave
-	if (num_matches == 0) { return; }
-
-
-	std::string result;
-	size_t difference = 0;
-
-	// if what we replace is larger than the match then it is easy
-	if (replacement.size() >= match.size())
+	if (positions.size() == 0) { return 0; }
+
+	const size_t original_size = value.size();
+	const size_t growth = positions.size() * (replacement.size() - match.size());
+	value.resize(original_size + growth);
+	char* data = value.data();
+
+	// the position of the first character after the part that is still left to move
+	size_t read_end = original_size;
+	// the position of the first character after the part that is still left to write
+	size_t write_end = value.size();
+	for (size_t i = positions.size(); i > 0; --i)
 	{
-		difference = value.size() + (num_matches * (replacement.size() - match.size()));
-	}
-	// if what we replace is smaller than the match then we have to convert numbers to a
-	// signed integer type so we can accept negative numbers
-	else 
-	{
-		// turn size_t to int64_t
-		int64_t positions_size = static_cast<int64_t>(num_matches);
-		int64_t replacement_size = static_cast<int64_t>(replacement.size());
-		int64_t match_size = static_cast<int64_t>(match.size());
-		// this value will never be negative
-		int64_t diff = positions_size * (match_size - replacement_size);
-		// after this calculation the number can never be negative as the input size is always
-		// larger, we have checked for this before
-		diff = static_cast<int64_t>(value.size()) - diff;
-
-#ifndef MTL_DISABLE_SOME_ASSERTS
-		MTL_ASSERT_MSG(diff >= 0,
-		"The number can't be negative. mtl::string::detail::replace_long contains errors.");
-#endif  // MTL_DISABLE_SOME_ASSERTS end
-
-		// convert to size_t with no problems as this can't be negative
-		difference = static_cast<size_t>(diff);
+		// move the part after this match
+		const size_t part_start = positions[i - 1] + match.size();
+		const size_t part_size = read_end - part_start;
+		write_end -= part_size;
+		std::memmove(data + write_end, data + part_start, part_size);
+		write_end -= replacement.size();
+		std::memcpy(data + write_end, replacement.data(), replacement.size());
+		read_end = positions[i - 1];
 	}
+	// the part before the first match is already in place
+	return positions.size();
+}
 
-	// resize to avoid unnecessary allocations
-	result.resize(difference); // GCOVR_EXCL_LINE
 
-	// create various iterators
-	const auto beginning = value.begin();
-	auto it_begin = value.begin();
-	auto it_end = value.begin();
-	auto it_output = result.begin();
 
-	// loop over the actual number of positions found and not the size of the array
-	for (size_t i = 0; i < num_matches; ++i)
+// Replaces all places in the input std::string where a match is found with the replacement 
+// std::string. Version specialized for handling long strings much faster. Returns the number of
+// replacements.
+inline size_t replace_long(std::string& value, std::string_view match,
+						   std::string_view replacement)
+{
+	// if input size is smaller than match then do nothing, this covers the cases where input size
+	// is 0
+	if (value.size() < match.size())
 	{
-		// GCOVR_EXCL_START
-		// copies parts to output string and moves the iterators along
-		it_end = std::next(beginning, static_cast<std::ptrdiff_t>(positions[i]));
-		std::copy(it_begin, it_end, it_output);
-		std::advance(it_output, std::distance(it_begin, it_end));
-		std::copy(replacement.begin(), replacement.end(), it_output);
-		std::advance(it_output, static_cast<std::ptrdiff_t>(replacement.size()));
-		it_begin = std::next(it_end, static_cast<std::ptrdiff_t>(match.size()));
-		// GCOVR_EXCL_STOP
+		return 0;
 	}
-	// copy from the last match to the end
-	std::copy(it_begin, value.end(), it_output); // GCOVR_EXCL_LINE
 
-	// copy the result to the input string
-	value = result; // GCOVR_EXCL_LINE
+	if (replacement.size() <= match.size())
+	{
+		return replace_long_shrink(value, match, replacement);
+	}
+	return replace_long_grow(value, match, replacement);
 }
 
 
@@ -1458,22 +4269,24 @@ inline void replace_long(std::string& value, const std::string& match,
 
 
 
-/// Replaces all places in the input where a match is found with the replacement.
+/// Replaces all places in the input where a match is found with the replacement. The match and
+/// the replacement must not view the input. If the match is empty nothing is replaced.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const std::string& match, const std::string& replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, std::string_view match, std::string_view replacement)
 {
+	// an empty match would never move the search forward so do nothing
+	if (match.empty()) { return 0; }
+
 	// if the string is relatively short use the algorithm for short strings
-	if (value.size() < 350)
+	if (value.size() < 128)
 	{
-		mtl::string::detail::replace_short(value, match, replacement);
+		return mtl::string::detail::replace_short(value, match, replacement);
 	}
 	// for longer strings there is another algorithm that is benchmarked and proven faster
-	else
-	{
-		mtl::string::detail::replace_long(value, match, replacement);
-	}
+	return mtl::string::detail::replace_long(value, match, replacement);
 }
 
 
@@ -1481,18 +4294,20 @@ inline void replace(std::string& value, const std::string& match, const std::str
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const std::string& match, const char replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, std::string_view match, const char replacement)
 {
-	replace(value, match, mtl::string::to_string(replacement));
+	return replace(value, match, std::string_view(&replacement, 1));
 }
 
 /// Replaces all places in the input where a match is found with the replacement.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const std::string& match, const char* replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, std::string_view match, const char* replacement)
 {
-	replace(value, match, mtl::string::to_string(replacement));
+	return replace(value, match, mtl::detail::to_string_view(replacement));
 }
 
 
@@ -1501,33 +4316,39 @@ inline void replace(std::string& value, const std::string& match, const char* re
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char match, const std::string& replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char match, std::string_view replacement)
 {
-	replace(value, mtl::string::to_string(match), replacement);
+	return replace(value, std::string_view(&match, 1), replacement);
 }
 
 /// Replaces all places in the input where a match is found with the replacement.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char match, const char replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char match, const char replacement)
 {
+	size_t count = 0;
 	for(char& character : value)
 	{
 		if(character == match)
 		{
 			character = replacement;
+			++count;
 		}
 	}
+	return count;
 }
 
 /// Replaces all places in the input where a match is found with the replacement.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char match, const char* replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char match, const char* replacement)
 {
-	replace(value, mtl::string::to_string(match), mtl::string::to_string(replacement));
+	return replace(value, std::string_view(&match, 1), mtl::detail::to_string_view(replacement));
 }
 
 
@@ -1535,32 +4356,124 @@ inline void replace(std::string& value, const char match, const char* replacemen
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char* match, const std::string& replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char* match, std::string_view replacement)
 {
-	replace(value, mtl::string::to_string(match), replacement);
+	return replace(value, mtl::detail::to_string_view(match), replacement);
 }
 
 /// Replaces all places in the input where a match is found with the replacement.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char* match, const char replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char* match, const char replacement)
 {
-	// GCOVR_EXCL_START
-	replace(value, mtl::string::to_string(match), mtl::string::to_string(replacement));
-	// GCOVR_EXCL_STOP
+	return replace(value, mtl::detail::to_string_view(match), std::string_view(&replacement, 1));
 }
 
 /// Replaces all places in the input where a match is found with the replacement.
 /// @param[in, out] value An std::string to replace parts that match with a replacement.
 /// @param[in] match A match to search for.
 /// @param[in] replacement A replacement to replace the matches with.
-inline void replace(std::string& value, const char* match, const char* replacement)
+/// @return The number of replacements.
+inline size_t replace(std::string& value, const char* match, const char* replacement)
+{
+	return replace(value, mtl::detail::to_string_view(match),
+				   mtl::detail::to_string_view(replacement));
+}
+
+
+
+// ================================================================================================
+// REPLACE_COPY - Copies the input to an output and replaces all places where a match is found
+//                with the replacement.
+// ================================================================================================
+
+/// Copies the input to the output and replaces all places where a match is found with the
+/// replacement. The input is never modified, so it can be any memory that can be viewed by an
+/// std::string_view such as a memory mapped file. The output iterator can be a pointer to a buffer
+/// or an insert iterator such as std::back_inserter. The output size is the input size plus the
+/// number of replacements multiplied by the size difference of the replacement and the match, so
+/// when the output is a pointer to a buffer the returned number is enough to find where the output
+/// ends. If the match is empty the input is copied without any replacements.
+/// @param[in] value The input to copy.
+/// @param[in] match A match to search for.
+/// @param[in] replacement A replacement to replace the matches with.
+/// @param[out] output An output iterator where the output will be written.
+/// @return The number of replacements.
+template<typename OutputIterator>
+inline size_t replace_copy(std::string_view value, std::string_view match,
+						   std::string_view replacement, OutputIterator output)
+{
+	const char* data = value.data();
+
+	// an empty match would never move the search forward so copy the input unchanged
+	if (match.empty())
+	{
+		std::copy(data, data + value.size(), output);
+		return 0;
+	}
+
+	size_t count = 0;
+	size_t start = 0;
+	size_t pos = mtl::detail::find_substring(value, match);
+	while (pos != std::string_view::npos)
+	{
+		// copy the part before the match and then the replacement
+		output = std::copy(data + start, data + pos, output);
+		output = std::copy(replacement.begin(), replacement.end(), output);
+		start = pos + match.size();
+		pos = mtl::detail::find_substring(value, match, start);
+		++count;
+	}
+
+	// copy from the last match to the end
+	std::copy(data + start, data + value.size(), output);
+	return count;
+}
+
+/// Appends the input to the output std::string and replaces all places where a match is found
+/// with the replacement. The input is never modified, so it can be any memory that can be viewed
+/// by an std::string_view such as a memory mapped file. If the match is empty the input is
+/// appended without any replacements.
+/// @param[in] value The input to copy.
+/// @param[in] match A match to search for.
+/// @param[in] replacement A replacement to replace the matches with.
+/// @param[out] result An std::string where the output will be appended.
+/// @return The number of replacements.
+inline size_t replace_copy(std::string_view value, std::string_view match,
+						   std::string_view replacement, std::string& result)
 {
-	replace(value, mtl::string::to_string(match), mtl::string::to_string(replacement));
+	// reserve for the size of the input, the output has the same size when nothing is replaced
+	result.reserve(result.size() + value.size());
+
+	if (match.empty())
+	{
+		result.append(value);
+		return 0;
+	}
+
+	size_t count = 0;
+	size_t start = 0;
+	size_t pos = mtl::detail::find_substring(value, match);
+	while (pos != std::string_view::npos)
+	{
+		// append the part before the match and then the replacement
+		result.append(value.data() + start, pos - start);
+		result.append(replacement);
+		start = pos + match.size();
+		pos = mtl::detail::find_substring(value, match, start);
+		++count;
+	}
+
+	// append from the last match to the end
+	result.append(value.data() + start, value.size() - start);
+	return count;
 }
 
 
+
 // ================================================================================================
 // REPLACE_ALL - Replaces all matches in the input with all the replacements.
 // ================================================================================================
@@ -1600,5 +4513,288 @@ replace_all(std::string& value, const ContainerMatches& container_matches,
 }
 
 
+
+// ================================================================================================
+// REPLACER         - Replaces many matches with their replacements in a single pass.
+// ================================================================================================
+
+/// Replaces many different matches with their replacements in a single pass over the input. All
+/// matches are compiled once to an Aho-Corasick automaton, so it can be reused to replace the
+/// same matches in many inputs. Unlike mtl::string::replace_all, that replaces each match in turn,
+/// all matches are found in the original input with a single pass and the output is written
+/// exactly once, so replacements are never searched for other matches. When matches overlap the
+/// one that starts first is replaced and if more than one start at the same position the longest
+/// one is replaced. If the same match is given more than once only the first one is used.
+class replacer
+{
+	// marks that no match ends at a state or that no match starts at a position
+	static constexpr uint32_t no_match = std::numeric_limits<uint32_t>::max();
+
+	// the transitions of the root state for every possible character, it is the only state with
+	// a transition for every character because it is visited far more often than the others
+	std::array<uint32_t, 256> root_transitions {};
+	// the children of each state are stored together, sorted by character, the children of a
+	// state are from child_offsets[state] up to child_offsets[state + 1]
+	std::vector<uint32_t> child_offsets;
+	// the character that leads to each child
+	std::vector<unsigned char> child_characters;
+	// the state of each child
+	std::vector<uint32_t> child_states;
+	// for each state the state of the longest proper suffix that is also in the trie
+	std::vector<uint32_t> failure;
+	// for each state the index of the match that ends at that state, or no_match
+	std::vector<uint32_t> state_matches;
+	// for each state the closest state reached through failure links where a match ends, or 0 if
+	// there isn't one, the root state can't be the end of a match because matches aren't empty
+	std::vector<uint32_t> match_links;
+	// the matches to search for
+	std::vector<std::string> matches;
+	// the replacement for each match
+	std::vector<std::string> replacements;
+
+	// the children of each state while the trie is built, sorted by character
+	using trie_children = std::vector<std::vector<std::pair<unsigned char, uint32_t>>>;
+
+	// Adds a match to the trie.
+	void add_match(trie_children& children, std::string_view match, std::string_view replacement)
+	{
+		if (match.empty())
+		{
+			throw std::invalid_argument("mtl::string::replacer requires matches to not be empty.");
+		}
+
+		uint32_t state = 0;
+		for (const char character : match)
+		{
+			const auto index = static_cast<unsigned char>(character);
+			auto& state_children = children[state];
+			auto it = std::lower_bound(state_children.begin(), state_children.end(), index,
+			[](const std::pair<unsigned char, uint32_t>& child, unsigned char value)
+			{
+				return child.first < value;
+			});
+
+			if ((it == state_children.end()) || (it->first != index))
+			{
+				const auto next = static_cast<uint32_t>(children.size());
+				// insert before adding the new state, adding it invalidates state_children
+				state_children.insert(it, std::make_pair(index, next));
+				children.emplace_back();
+				state_matches.push_back(no_match);
+				state = next;
+			}
+			else
+			{
+				state = it->second;
+			}
+		}
+
+		// if the same match was already added keep the first one
+		if (state_matches[state] == no_match)
+		{
+			state_matches[state] = static_cast<uint32_t>(matches.size());
+			matches.emplace_back(match);
+			replacements.emplace_back(replacement);
+		}
+	}
+
+	// Returns the state reached from a state with the given character, following failure links
+	// until a state with a transition for that character or the root is found.
+	[[nodiscard]]
+	uint32_t next_state(uint32_t state, const unsigned char character) const noexcept
+	{
+		while (state != 0)
+		{
+			// most states have very few children so a linear search is the fastest
+			const uint32_t last = child_offsets[state + 1];
+			for (uint32_t i = child_offsets[state]; i < last; ++i)
+			{
+				if (child_characters[i] == character) { return child_states[i]; }
+			}
+			state = failure[state];
+		}
+		return root_transitions[character];
+	}
+
+	// Stores the trie in a compact form and computes the failure links with a breadth first
+	// traversal.
+	void build(const trie_children& children)
+	{
+		const size_t state_count = children.size();
+
+		child_offsets.assign(state_count + 1, 0);
+		for (size_t state = 0; state < state_count; ++state)
+		{
+			child_offsets[state + 1] = child_offsets[state] +
+									   static_cast<uint32_t>(children[state].size());
+		}
+		child_characters.resize(child_offsets[state_count]);
+		child_states.resize(child_offsets[state_count]);
+		for (size_t state = 0; state < state_count; ++state)
+		{
+			size_t position = child_offsets[state];
+			for (const auto& child : children[state])
+			{
+				child_characters[position] = child.first;
+				child_states[position] = child.second;
+				++position;
+			}
+		}
+
+		root_transitions.fill(0);
+		for (const auto& child : children[0]) { root_transitions[child.first] = child.second; }
+
+		failure.assign(state_count, 0);
+		match_links.assign(state_count, 0);
+		std::vector<uint32_t> queue;
+		queue.reserve(state_count);
+
+		// the states right after the root fail back to the root
+		for (const auto& child : children[0]) { queue.push_back(child.second); }
+
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			const uint32_t state = queue[i];
+			const uint32_t fail_state = failure[state];
+
+			// the closest state with a match following failure links
+			if (state_matches[fail_state] != no_match)
+			{
+				match_links[state] = fail_state;
+			}
+			else
+			{
+				match_links[state] = match_links[fail_state];
+			}
+
+			// the failure links of the states closer to the root are already computed
+			for (const auto& child : children[state])
+			{
+				failure[child.second] = next_state(fail_state, child.first);
+				queue.push_back(child.second);
+			}
+		}
+	}
+
+public:
+
+	/// Default constructor. Doesn't replace anything.
+	replacer() : state_matches(1, no_match)
+	{
+	}
+
+	/// Compiles the matches and their replacements. The match at each position of the matches
+	/// container is replaced by the element at the same position of the replacements container.
+	/// If the number of elements for the containers isn't the same or if any match is empty it
+	/// throws std::invalid_argument. The element type for both containers should be convertible to
+	/// std::string_view.
+	/// @param[in] container_matches A container of matches to search for.
+	/// @param[in] container_replacements A container of replacements to replace the matches with.
+	template<typename ContainerMatches, typename ContainerReplacements>
+	replacer(const ContainerMatches& container_matches,
+			 const ContainerReplacements& container_replacements) : replacer()
+	{
+		if (container_matches.size() != container_replacements.size())
+		{
+			throw std::invalid_argument(
+			"mtl::string::replacer requires the containers to be the same size.");
+		}
+
+		trie_children children(1);
+		auto it_replacement = container_replacements.begin();
+		for (const auto& match : container_matches)
+		{
+			add_match(children, match, *it_replacement);
+			++it_replacement;
+		}
+		build(children);
+	}
+
+
+	// ============================================================================================
+	// SIZE             - Returns the number of different matches.
+	// ============================================================================================
+
+	/// Returns the number of different matches.
+	/// @return The number of different matches.
+	[[nodiscard]]
+	size_t size() const noexcept { return matches.size(); }
+
+
+	// ============================================================================================
+	// REPLACE          - Replaces all matches with their replacements.
+	// ============================================================================================
+
+	/// Replaces all places in the input where any of the matches is found with its replacement.
+	/// @param[in, out] value An std::string to replace parts that match with a replacement.
+	void replace(std::string& value) const
+	{
+		if (matches.empty() || value.empty()) { return; }
+
+		// for each position the index of the longest match that starts there, or no_match
+		std::vector<uint32_t> starts(value.size(), no_match);
+		bool found = false;
+		uint32_t state = 0;
+		for (size_t i = 0; i < value.size(); ++i)
+		{
+			state = next_state(state, static_cast<unsigned char>(value[i]));
+
+			// the match that ends at this state is the longest one, shorter ones follow the links
+			uint32_t match_state = state;
+			if (state_matches[match_state] == no_match) { match_state = match_links[match_state]; }
+			while (match_state != 0)
+			{
+				// longer matches with the same start end later so they always overwrite
+				// shorter ones
+				const uint32_t match_index = state_matches[match_state];
+				starts[i + 1 - matches[match_index].size()] = match_index;
+				found = true;
+				match_state = match_links[match_state];
+			}
+		}
+
+		if (found == false) { return; }
+
+		// replace the matches that start first and skip those that overlap with them
+		size_t result_size = value.size();
+		for (size_t i = 0; i < value.size();)
+		{
+			if (starts[i] == no_match) { ++i; continue; }
+			const uint32_t match_index = starts[i];
+			result_size = result_size - matches[match_index].size() +
+						  replacements[match_index].size();
+			i += matches[match_index].size();
+		}
+
+		// write the output exactly once
+		std::string result;
+		result.reserve(result_size);
+		size_t start = 0;
+		for (size_t i = 0; i < value.size();)
+		{
+			if (starts[i] == no_match) { ++i; continue; }
+			const uint32_t match_index = starts[i];
+			result.append(value, start, i - start);
+			result.append(replacements[match_index]);
+			i += matches[match_index].size();
+			start = i;
+		}
+		result.append(value, start, std::string::npos);
+
+		value.swap(result);
+	}
+};
+
+
+/// Replaces all places in the input where any of the matches of a compiled mtl::string::replacer
+/// is found with its replacement, in a single pass.
+/// @param[in, out] value An std::string to replace parts that match with a replacement.
+/// @param[in] compiled_replacer An mtl::string::replacer with the matches and replacements.
+inline void replace_all(std::string& value, const mtl::string::replacer& compiled_replacer)
+{
+	compiled_replacer.replace(value);
+}
+
+
 } // namespace string end
 } // namespace mtl end
@@ -209,6 +209,14 @@ TEST_CASE("mtl::console::print multiple items")
                             comma, c, nl, cc, nl, uc, nl));
 }
 
+TEST_CASE("mtl::console::print with mtl::string::builder")
+{
+    mtl::string::builder sb;
+    sb.append("Numbers : ").append(10).append(' ').append(10.1);
+    REQUIRE_NOTHROW(mtl::console::print(sb));
+    REQUIRE_NOTHROW(mtl::console::print('\n', sb, '\n'));
+}
+
 
 // ---------------------
 // mtl::console::println
@@ -6,11 +6,19 @@
 // See ThirdPartyNotices.txt in the project root for third party licenses information.
 
 #include "doctest_include.hpp" 
-#include <vector>     // std::vector
-#include <list>       // std::list
-#include <string>     // std::string, std::to_string
-#include <filesystem> // std::filesystem::is_regular_file, std::filesystem::remove
-                      // std::filesystem::file_size, std::filesystem::path
+#include <vector>      // std::vector
+#include <list>        // std::list
+#include <string>      // std::string, std::to_string
+#include <string_view> // std::string_view
+#include <filesystem>  // std::filesystem::is_regular_file, std::filesystem::remove
+                       // std::filesystem::file_size, std::filesystem::path,
+                       // std::filesystem::create_directory, std::filesystem::is_directory,
+                       // std::filesystem::remove_all
+#include <utility>     // std::move
+#include <type_traits> // std::is_copy_constructible_v, std::is_copy_assignable_v,
+                       // std::is_move_constructible_v
+#include <thread>      // std::thread
+#include <array>       // std::array
 
 
 // Disable some asserts so we can test more thoroughly.
@@ -18,8 +26,36 @@
 
 
 #include "../mtl/filesystem.hpp" 
-// mtl::filesystem::read_file, mtl::filesystem::read_all_lines, 
-// mtl::filesystem::write_file, mtl::filesystem::write_all_lines
+// mtl::filesystem::read_file, mtl::filesystem::read_all_lines, mtl::filesystem::write_file,
+// mtl::filesystem::write_all_lines, mtl::filesystem::for_each_line,
+// [@class] mtl::filesystem::mapped_file, mtl::filesystem::mapped_file::open,
+// mtl::filesystem::mapped_file::close, mtl::filesystem::mapped_file::is_open,
+// mtl::filesystem::mapped_file::data, mtl::filesystem::mapped_file::size,
+// mtl::filesystem::mapped_file::empty, mtl::filesystem::mapped_file::view,
+// [@class] mtl::filesystem::file_lines, mtl::filesystem::file_lines::begin,
+// mtl::filesystem::file_lines::end, mtl::filesystem::file_lines::size,
+// mtl::filesystem::file_lines::empty, mtl::filesystem::file_lines::text,
+// mtl::filesystem::file_lines::clear, [@class] mtl::filesystem::line_reader,
+// mtl::filesystem::line_reader::open, mtl::filesystem::line_reader::close,
+// mtl::filesystem::line_reader::is_open, mtl::filesystem::line_reader::read_line,
+// mtl::filesystem::read_all_lines_par, [@class] mtl::filesystem::file_writer,
+// mtl::filesystem::file_writer::open, mtl::filesystem::file_writer::close,
+// mtl::filesystem::file_writer::is_open, mtl::filesystem::file_writer::buffer_size,
+// mtl::filesystem::file_writer::write, mtl::filesystem::file_writer::write_line,
+// mtl::filesystem::file_writer::write_lines, mtl::filesystem::file_writer::flush,
+// [@class] mtl::filesystem::async_file_writer, mtl::filesystem::async_file_writer::open,
+// mtl::filesystem::async_file_writer::close, mtl::filesystem::async_file_writer::is_open,
+// mtl::filesystem::async_file_writer::write, mtl::filesystem::async_file_writer::write_line,
+// mtl::filesystem::async_file_writer::flush, mtl::filesystem::write_binary,
+// mtl::filesystem::read_binary, [@class] mtl::filesystem::mapped_binary,
+// mtl::filesystem::mapped_binary::open, mtl::filesystem::mapped_binary::close,
+// mtl::filesystem::mapped_binary::is_open, mtl::filesystem::mapped_binary::data,
+// mtl::filesystem::mapped_binary::size, mtl::filesystem::mapped_binary::empty,
+// mtl::filesystem::mapped_binary::begin, mtl::filesystem::mapped_binary::end,
+// mtl::filesystem::read_files_par, [@class] mtl::filesystem::file_buffer,
+// mtl::filesystem::file_buffer::data, mtl::filesystem::file_buffer::size,
+// mtl::filesystem::file_buffer::empty, mtl::filesystem::file_buffer::view,
+// mtl::filesystem::file_buffer::clear
 
 
 
@@ -158,6 +194,125 @@ TEST_CASE("mtl::filesystem::read_file with non-existent file")
     std::filesystem::remove(non_existent);
 }
 
+TEST_CASE("mtl::filesystem::read_file with a directory")
+{
+    filename_generator fname_generator;
+    const std::string directory = fname_generator.generate_filename();
+
+    // delete the directory used for this test case if it exists from a previous failed run
+    std::filesystem::remove(directory);
+    std::filesystem::create_directory(directory);
+    REQUIRE_EQ((std::filesystem::is_directory(directory)), true);
+
+    // a directory is not a regular file so it can't be read
+    std::string file_data;
+    bool read_file = mtl::filesystem::read_file(directory, file_data);
+    REQUIRE_EQ(file_data.empty(), true);
+    REQUIRE_EQ(read_file, false);
+
+    // delete the directory used for this test case
+    std::filesystem::remove(directory);
+}
+
+TEST_CASE("mtl::filesystem::read_file with non-empty output")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, text1);
+    REQUIRE_EQ(written_correctly, true);
+
+    // the output is replaced by the contents of the file no matter what it contained before
+    std::string file_data = text2 + text2;
+    bool read_correctly = mtl::filesystem::read_file(filename, file_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(file_data.size(), text1.size());
+    REQUIRE_EQ((file_data == text1), true);
+
+    file_data = "abc";
+    read_correctly = mtl::filesystem::read_file(filename, file_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((file_data == text1), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer::data
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer::size
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer::empty
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer::view
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_buffer::clear
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::file_buffer")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the files used for this test case if they exist from a previous failed run
+    std::filesystem::remove(filename);
+    std::filesystem::remove(non_existent);
+
+    // a default constructed file_buffer is empty
+    mtl::filesystem::file_buffer buffer;
+    CHECK_EQ(buffer.empty(), true);
+    CHECK_EQ(buffer.size(), 0);
+    CHECK_EQ(buffer.data(), nullptr);
+    CHECK_EQ(buffer.view().empty(), true);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, text1);
+    REQUIRE_EQ(written_correctly, true);
+
+    bool read_correctly = mtl::filesystem::read_file(filename, buffer);
+    REQUIRE_EQ(read_correctly, true);
+    CHECK_EQ(buffer.empty(), false);
+    CHECK_EQ(buffer.size(), text1.size());
+    CHECK_EQ(buffer.view(), std::string_view(text1));
+
+    // the contents remain valid when the file_buffer is moved
+    const char* const contents = buffer.data();
+    mtl::filesystem::file_buffer moved_buffer = std::move(buffer);
+    CHECK_EQ(moved_buffer.data(), contents);
+    CHECK_EQ(moved_buffer.view(), std::string_view(text1));
+    CHECK_EQ((std::is_copy_constructible_v<mtl::filesystem::file_buffer>), false);
+
+    // reading again replaces the contents
+    written_correctly = mtl::filesystem::write_file(filename, text2);
+    REQUIRE_EQ(written_correctly, true);
+    read_correctly = mtl::filesystem::read_file(filename, moved_buffer);
+    REQUIRE_EQ(read_correctly, true);
+    CHECK_EQ(moved_buffer.view(), std::string_view(text2));
+
+    // an empty file gives an empty file_buffer
+    written_correctly = mtl::filesystem::write_file(filename, std::string());
+    REQUIRE_EQ(written_correctly, true);
+    read_correctly = mtl::filesystem::read_file(filename, moved_buffer);
+    REQUIRE_EQ(read_correctly, true);
+    CHECK_EQ(moved_buffer.empty(), true);
+
+    // a file that doesn't exist can't be read
+    moved_buffer.clear();
+    read_correctly = mtl::filesystem::read_file(non_existent, moved_buffer);
+    CHECK_EQ(read_correctly, false);
+    CHECK_EQ(moved_buffer.empty(), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
 
 // ------------------------------------------------------------------------------------------------
 // mtl::filesystem::write_file and mtl::filesystem::read_file
@@ -909,6 +1064,267 @@ TEST_CASE("mtl::filesystem::read_all_lines with non-empty output and mixed LF an
 
 
 
+TEST_CASE("mtl::filesystem::read_all_lines with newlines at every position of long text")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // long enough text so newlines end up in every position of the blocks processed with SIMD,
+    // as well as in the remaining characters at the end that are processed one at a time
+    std::string base;
+    for (int i = 0; i < 150; ++i)
+    {
+        base.push_back(static_cast<char>('a' + (i % 26)));
+    }
+
+    for (size_t position = 0; position < base.size(); position += 7)
+    {
+        // place LF and CRLF at different positions
+        std::string text = base;
+        text[position] = '\n';
+        text[(position * 3) % text.size()] = '\n';
+        if (position > 0)
+        {
+            text[position - 1] = '\r';
+        }
+
+        // split the text at newlines one character at a time to find the correct result
+        std::vector<std::string> correct_data;
+        std::string current;
+        for (const char character : text)
+        {
+            if (character == '\n')
+            {
+                if ((current.empty() == false) && (current.back() == '\r'))
+                {
+                    current.pop_back();
+                }
+                correct_data.emplace_back(current);
+                current.clear();
+            }
+            else
+            {
+                current.push_back(character);
+            }
+        }
+        if (current.empty() == false)
+        {
+            correct_data.emplace_back(current);
+        }
+
+        bool written_correctly = mtl::filesystem::write_file(filename, text);
+        REQUIRE_EQ(written_correctly, true);
+
+        std::vector<std::string> read_lines;
+        bool read_correctly = mtl::filesystem::read_all_lines(filename, read_lines);
+        REQUIRE_EQ(read_correctly, true);
+        REQUIRE_EQ((read_lines == correct_data), true);
+
+        mtl::filesystem::file_lines lines;
+        read_correctly = mtl::filesystem::read_all_lines(filename, lines);
+        REQUIRE_EQ(read_correctly, true);
+        REQUIRE_EQ(lines.size(), correct_data.size());
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            REQUIRE_EQ((lines[i] == correct_data[i]), true);
+        }
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::read_all_lines_par
+// ------------------------------------------------------------------------------------------------
+
+// Creates text larger than the size where mtl::filesystem::read_all_lines_par starts using
+// multiple threads. The text contains empty lines and lines of different sizes with both LF and
+// CRLF.
+std::string create_large_text(const bool newline_at_end)
+{
+    std::string text;
+    size_t line_number = 0;
+    while (text.size() < (3 * 1024 * 1024))
+    {
+        text += text1.substr(0, line_number % 37);
+        text += std::to_string(line_number);
+        // add empty lines every now and then
+        if ((line_number % 11) == 0)
+        {
+            text += "\n";
+        }
+        if ((line_number % 3) == 0)
+        {
+            text += "\r\n";
+        }
+        else
+        {
+            text += "\n";
+        }
+        ++line_number;
+    }
+
+    if (newline_at_end == false)
+    {
+        text += text2;
+    }
+
+    return text;
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with non-existent file")
+{
+    filename_generator fname_generator;
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(non_existent);
+
+    // make sure the file doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+
+    std::vector<std::string> lines;
+    bool read_lines = mtl::filesystem::read_all_lines_par(non_existent, lines);
+
+    REQUIRE_EQ(lines.empty(), true);
+    REQUIRE_EQ(read_lines, false);
+
+    // make sure the file still doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with empty file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, std::string());
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<std::string> lines;
+    bool read_correctly = mtl::filesystem::read_all_lines_par(filename, lines, 4);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(lines.empty(), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with non-empty output and small file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string text = text1 + "\r\n\n" + text2 + "\n" + text1 + "\r\n";
+    bool written_correctly = mtl::filesystem::write_file(filename, text);
+    REQUIRE_EQ(written_correctly, true);
+
+    // files this small are always read with a single thread
+    std::vector<std::string> lines { text2 };
+    bool read_correctly = mtl::filesystem::read_all_lines_par(filename, lines, 8);
+    REQUIRE_EQ(read_correctly, true);
+    const std::vector<std::string> desired { text2, text1, "", text2, text1 };
+    REQUIRE_EQ((lines == desired), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with large file and newline at the end")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, create_large_text(true));
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<std::string> desired;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, desired);
+    REQUIRE_EQ(read_correctly, true);
+
+    // the result has to be the same no matter how many threads are used
+    for (size_t threads = 0; threads < 9; ++threads)
+    {
+        std::vector<std::string> lines;
+        read_correctly = mtl::filesystem::read_all_lines_par(filename, lines, threads);
+        REQUIRE_EQ(read_correctly, true);
+        REQUIRE_EQ(lines.size(), desired.size());
+        REQUIRE_EQ((lines == desired), true);
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with large file and no newline at the end")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, create_large_text(false));
+    REQUIRE_EQ(written_correctly, true);
+
+    std::list<std::string> desired { text1 };
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, desired);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((desired.back() == text2), true);
+
+    // the result has to be the same no matter how many threads are used
+    for (size_t threads = 1; threads < 8; threads += 3)
+    {
+        std::list<std::string> lines { text1 };
+        read_correctly = mtl::filesystem::read_all_lines_par(filename, lines, threads);
+        REQUIRE_EQ(read_correctly, true);
+        REQUIRE_EQ((lines == desired), true);
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::read_all_lines_par with large file with a single line")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // a file without newlines can't be split to chunks so a single thread reads it
+    const std::string text(3 * 1024 * 1024, 'a');
+    bool written_correctly = mtl::filesystem::write_file(filename, text + "\r\n");
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<std::string> lines;
+    bool read_correctly = mtl::filesystem::read_all_lines_par(filename, lines, 4);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(lines.size(), 1);
+    REQUIRE_EQ((lines[0] == text), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
 // ------------------------------------------------------------------------------------------------
 // mtl::filesystem::write_all_lines
 // ------------------------------------------------------------------------------------------------
@@ -1169,6 +1585,47 @@ TEST_CASE("mtl::filesystem::write_all_lines and read_all_lines non-empty output
 }
 
 
+TEST_CASE("mtl::filesystem::write_all_lines with a single empty element")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // a single empty element writes an empty file
+    std::vector<std::string> single_empty { "" };
+    bool written_correctly = mtl::filesystem::write_all_lines(filename, single_empty.begin(),
+                                                              single_empty.end());
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ((std::filesystem::is_regular_file(filename)), true);
+    REQUIRE_EQ(std::filesystem::file_size(filename), 0);
+
+    // more than one empty element writes a newline for each of them
+    std::vector<std::string> two_empty { "", "" };
+    written_correctly = mtl::filesystem::write_all_lines(filename, two_empty.begin(),
+                                                         two_empty.end());
+    REQUIRE_EQ(written_correctly, true);
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == "\n\n"), true);
+
+    // a single non-empty element is followed by a newline
+    std::vector<int> single_number { 5 };
+    written_correctly = mtl::filesystem::write_all_lines(filename, single_number.begin(),
+                                                         single_number.end());
+    REQUIRE_EQ(written_correctly, true);
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == "5\n"), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
 TEST_CASE("mtl::filesystem::write_all_lines write / append and mtl::filesystem::read_all_lines")
 {
     filename_generator fname_generator;
@@ -1641,6 +2098,1288 @@ TEST_CASE("mtl::filesystem::write_all_lines with mtl::filesystem::read_file")
 
 
 
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::close
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::is_open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::data
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::size
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::empty
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_file::view
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::mapped_file with non-existent file")
+{
+    filename_generator fname_generator;
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(non_existent);
+
+    // make sure the file doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+
+    mtl::filesystem::mapped_file file;
+    REQUIRE_EQ(file.is_open(), false);
+
+    bool opened = file.open(non_existent);
+    REQUIRE_EQ(opened, false);
+    REQUIRE_EQ(file.is_open(), false);
+    REQUIRE_EQ(file.empty(), true);
+    REQUIRE_EQ(file.size(), 0);
+    REQUIRE_EQ((file.data() == nullptr), true);
+    REQUIRE_EQ(file.view().empty(), true);
+
+    // make sure the file still doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+}
+
+TEST_CASE("mtl::filesystem::mapped_file with empty file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string empty;
+    bool written_correctly = mtl::filesystem::write_file(filename, empty);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ((std::filesystem::is_regular_file(filename)), true);
+
+    // an empty file is opened successfully but there is nothing mapped
+    mtl::filesystem::mapped_file file(filename);
+    REQUIRE_EQ(file.is_open(), true);
+    REQUIRE_EQ(file.empty(), true);
+    REQUIRE_EQ(file.size(), 0);
+    REQUIRE_EQ(file.view().empty(), true);
+
+    file.close();
+    REQUIRE_EQ(file.is_open(), false);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::mapped_file with mtl::filesystem::write_file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string data = text1 + "\r\n" + text2 + "\n";
+    bool written_correctly = mtl::filesystem::write_file(filename, data);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ((std::filesystem::is_regular_file(filename)), true);
+
+    {
+        mtl::filesystem::mapped_file file(filename);
+        REQUIRE_EQ(file.is_open(), true);
+        REQUIRE_EQ(file.empty(), false);
+        REQUIRE_EQ(file.size(), data.size());
+        REQUIRE_EQ((file.data() != nullptr), true);
+        REQUIRE_EQ((file.view() == data), true);
+
+        // reopening the same file unmaps the previous mapping first
+        bool reopened = file.open(filename);
+        REQUIRE_EQ(reopened, true);
+        REQUIRE_EQ((file.view() == data), true);
+    }
+
+    // delete the file used for this test case, the file has to be unmapped before we can delete
+    // it in Windows
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::mapped_file move constructor and move assignment")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, text1);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ((std::filesystem::is_regular_file(filename)), true);
+
+    REQUIRE_EQ(std::is_copy_constructible_v<mtl::filesystem::mapped_file>, false);
+    REQUIRE_EQ(std::is_copy_assignable_v<mtl::filesystem::mapped_file>, false);
+
+    {
+        mtl::filesystem::mapped_file file1(filename);
+        REQUIRE_EQ(file1.is_open(), true);
+
+        // move constructor leaves the moved from object closed
+        mtl::filesystem::mapped_file file2(std::move(file1));
+        REQUIRE_EQ(file2.is_open(), true);
+        REQUIRE_EQ((file2.view() == text1), true);
+
+        // move assignment leaves the moved from object closed
+        mtl::filesystem::mapped_file file3;
+        file3 = std::move(file2);
+        REQUIRE_EQ(file3.is_open(), true);
+        REQUIRE_EQ((file3.view() == text1), true);
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::mapped_file with mtl::filesystem::read_all_lines")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // create a file large enough to span multiple memory pages
+    std::vector<std::string> data;
+    for (int i = 0; i < 10000; ++i)
+    {
+        data.emplace_back(std::to_string(i) + text1);
+    }
+
+    bool written_correctly = mtl::filesystem::write_all_lines(filename, data.begin(), data.end());
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ((std::filesystem::is_regular_file(filename)), true);
+
+    std::vector<std::string> read_lines;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, read_lines);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_lines.size() == data.size()), true);
+    REQUIRE_EQ((read_lines == data), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::begin
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::end
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::size
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::empty
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::text
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_lines::clear
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::file_lines with non-existent file")
+{
+    filename_generator fname_generator;
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(non_existent);
+
+    // make sure the file doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+
+    mtl::filesystem::file_lines lines;
+    bool read_lines = mtl::filesystem::read_all_lines(non_existent, lines);
+
+    REQUIRE_EQ(read_lines, false);
+    REQUIRE_EQ(lines.empty(), true);
+    REQUIRE_EQ(lines.size(), 0);
+    REQUIRE_EQ(lines.text().empty(), true);
+}
+
+TEST_CASE("mtl::filesystem::file_lines with empty file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string empty;
+    bool written_correctly = mtl::filesystem::write_file(filename, empty);
+    REQUIRE_EQ(written_correctly, true);
+
+    mtl::filesystem::file_lines lines;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, lines);
+
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(lines.empty(), true);
+    REQUIRE_EQ((lines.begin() == lines.end()), true);
+    REQUIRE_EQ(lines.text().empty(), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::file_lines produces the same lines as read_all_lines")
+{
+    const std::vector<std::string> inputs
+    {
+        "a", "\n", "\r\n", "\r", "abc\r", "\n\n\n", "\r\n\r\n", "\n\r\n\n\r\n",
+        "Hi \nHi\n Hi \n Hi\n\n Hi \n\n Hi\n\n Hi \n \nHi",
+        "Hi \r\nHi\r\n Hi \r\n Hi\r\n\r\n Hi \r\n\r\n Hi\r\n\r\n Hi \r\n \r\nHi",
+        "\nR\r\nG\nB\r\nCMYK\n\r\nR\nG\r\nB\n\n",
+        text1 + "\n" + text2 + "\r\n" + text1
+    };
+
+    for (const auto& input : inputs)
+    {
+        filename_generator fname_generator;
+        const std::string filename = fname_generator.generate_filename();
+
+        // delete the file used for this test case if it exists from a previous failed run
+        std::filesystem::remove(filename);
+
+        bool written_correctly = mtl::filesystem::write_file(filename, input);
+        REQUIRE_EQ(written_correctly, true);
+
+        std::vector<std::string> correct_data;
+        bool read_correctly = mtl::filesystem::read_all_lines(filename, correct_data);
+        REQUIRE_EQ(read_correctly, true);
+
+        mtl::filesystem::file_lines lines;
+        read_correctly = mtl::filesystem::read_all_lines(filename, lines);
+        REQUIRE_EQ(read_correctly, true);
+        REQUIRE_EQ((lines.text() == input), true);
+        REQUIRE_EQ(lines.size(), correct_data.size());
+
+        size_t index = 0;
+        for (const auto line : lines)
+        {
+            REQUIRE_EQ((line == correct_data[index]), true);
+            REQUIRE_EQ((lines[index] == correct_data[index]), true);
+            ++index;
+        }
+
+        // delete the file used for this test case
+        std::filesystem::remove(filename);
+    }
+}
+
+TEST_CASE("mtl::filesystem::file_lines lines remain valid after move")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // use a short file so the lines would be invalidated if the contents used small buffer
+    // optimization
+    const std::vector<std::string> data { "R", "G", "B", "", "CMYK" };
+    bool written_correctly = mtl::filesystem::write_all_lines(filename, data.begin(), data.end());
+    REQUIRE_EQ(written_correctly, true);
+
+    mtl::filesystem::file_lines lines;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, lines);
+    REQUIRE_EQ(read_correctly, true);
+
+    // delete the file to make sure the lines don't depend on it
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::file_lines moved_lines(std::move(lines));
+    REQUIRE_EQ(moved_lines.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        REQUIRE_EQ((moved_lines[i] == data[i]), true);
+    }
+
+    moved_lines.clear();
+    REQUIRE_EQ(moved_lines.empty(), true);
+    REQUIRE_EQ(moved_lines.text().empty(), true);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::line_reader
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::line_reader::open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::line_reader::close
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::line_reader::is_open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::line_reader::read_line
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::line_reader with non-existent file")
+{
+    filename_generator fname_generator;
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(non_existent);
+
+    // make sure the file doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+
+    mtl::filesystem::line_reader reader(non_existent);
+    REQUIRE_EQ(reader.is_open(), false);
+
+    std::string_view line;
+    REQUIRE_EQ(reader.read_line(line), false);
+
+    // make sure the file still doesn't exist
+    REQUIRE_EQ((std::filesystem::is_regular_file(non_existent)), false);
+}
+
+TEST_CASE("mtl::filesystem::line_reader with empty file")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string empty;
+    bool written_correctly = mtl::filesystem::write_file(filename, empty);
+    REQUIRE_EQ(written_correctly, true);
+
+    {
+        mtl::filesystem::line_reader reader(filename);
+        REQUIRE_EQ(reader.is_open(), true);
+
+        std::string_view line;
+        REQUIRE_EQ(reader.read_line(line), false);
+        REQUIRE_EQ(reader.read_line(line), false);
+
+        reader.close();
+        REQUIRE_EQ(reader.is_open(), false);
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::line_reader produces the same lines as read_all_lines")
+{
+    // build a line longer than any of the chunk sizes we test with
+    std::string long_line;
+    for (int i = 0; i < 100; ++i)
+    {
+        long_line += text1;
+    }
+
+    const std::vector<std::string> inputs
+    {
+        "a", "\n", "\r\n", "\r", "abc\r", "\n\n\n", "\r\n\r\n", "\n\r\n\n\r\n",
+        "Hi \nHi\n Hi \n Hi\n\n Hi \n\n Hi\n\n Hi \n \nHi",
+        "Hi \r\nHi\r\n Hi \r\n Hi\r\n\r\n Hi \r\n\r\n Hi\r\n\r\n Hi \r\n \r\nHi",
+        "\nR\r\nG\nB\r\nCMYK\n\r\nR\nG\r\nB\n\n",
+        text1 + "\n" + text2 + "\r\n" + text1,
+        long_line + "\r\n" + long_line + "\n\n" + long_line
+    };
+
+    const std::vector<size_t> chunk_sizes { 0, 1, 2, 3, 7, 64, 4096 };
+
+    for (const auto& input : inputs)
+    {
+        filename_generator fname_generator;
+        const std::string filename = fname_generator.generate_filename();
+
+        // delete the file used for this test case if it exists from a previous failed run
+        std::filesystem::remove(filename);
+
+        bool written_correctly = mtl::filesystem::write_file(filename, input);
+        REQUIRE_EQ(written_correctly, true);
+
+        std::vector<std::string> correct_data;
+        bool read_correctly = mtl::filesystem::read_all_lines(filename, correct_data);
+        REQUIRE_EQ(read_correctly, true);
+
+        for (const auto chunk_size : chunk_sizes)
+        {
+            std::vector<std::string> read_lines;
+            {
+                mtl::filesystem::line_reader reader(filename, chunk_size);
+                REQUIRE_EQ(reader.is_open(), true);
+                std::string_view line;
+                while (reader.read_line(line))
+                {
+                    read_lines.emplace_back(line);
+                }
+            }
+            REQUIRE_EQ((read_lines == correct_data), true);
+        }
+
+        // delete the file used for this test case
+        std::filesystem::remove(filename);
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::for_each_line
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::for_each_line with non-existent file")
+{
+    filename_generator fname_generator;
+    const std::string non_existent = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(non_existent);
+
+    size_t count = 0;
+    bool read_correctly = mtl::filesystem::for_each_line(non_existent, 
+                                                         [&count](std::string_view) { ++count; });
+    REQUIRE_EQ(read_correctly, false);
+    REQUIRE_EQ(count, 0);
+}
+
+TEST_CASE("mtl::filesystem::for_each_line with mixed LF and CRLF")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::string text_with_newline = "\nR\r\nG\nB\r\nCMYK\n\r\nR\nG\r\nB\n\n";
+    bool written_correctly = mtl::filesystem::write_file(filename, text_with_newline);
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<std::string> read_lines;
+    bool read_correctly = mtl::filesystem::for_each_line(filename, [&read_lines](auto line)
+    {
+        read_lines.emplace_back(line);
+    }, 5);
+
+    REQUIRE_EQ(read_correctly, true);
+
+    const std::vector<std::string> correct_data
+    { "", "R", "G", "B", "CMYK", "", "R", "G", "B", "", };
+    REQUIRE_EQ((read_lines == correct_data), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::close
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::is_open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::buffer_size
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::write
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::write_line
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::write_lines
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::file_writer::flush
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::file_writer with elements of different types")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::file_writer writer;
+    REQUIRE_EQ(writer.is_open(), false);
+    REQUIRE_EQ(writer.open(filename), true);
+    REQUIRE_EQ(writer.is_open(), true);
+    REQUIRE_EQ(writer.buffer_size(), mtl::filesystem::file_writer::default_buffer_size);
+
+    writer.write(text1);
+    writer.write('|');
+    writer.write("abc");
+    writer.write(std::string_view("def"));
+    writer.write(1024);
+    writer.write_line(true);
+    writer.write_line(2.5f);
+    writer.write_line(text2);
+    writer.close();
+    REQUIRE_EQ(writer.is_open(), false);
+
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "|abcdef1024true\n2.5\n" + text2 + "\n"), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::file_writer with small buffer and flush")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::file_writer writer(filename, false, 4);
+    REQUIRE_EQ(writer.is_open(), true);
+    REQUIRE_EQ(writer.buffer_size(), 4);
+
+    // the data fit in the buffer so nothing is written to the file yet
+    writer.write("ab");
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(read_data.empty(), true);
+
+    // after flushing the data are in the file
+    writer.flush();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == "ab"), true);
+
+    // data larger than the buffer are written directly to the file
+    std::string desired = "ab";
+    for (size_t i = 0; i < 100; ++i)
+    {
+        writer.write('x');
+        writer.write(text1);
+        writer.write_line(i);
+        desired += "x" + text1 + std::to_string(i) + "\n";
+    }
+    writer.flush();
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == desired), true);
+
+    // flushing after closing does nothing
+    writer.close();
+    writer.flush();
+    REQUIRE_EQ(writer.is_open(), false);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::file_writer with append and 0 buffer size")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, text1);
+    REQUIRE_EQ(written_correctly, true);
+
+    {
+        // a buffer size of 0 uses the default buffer size
+        mtl::filesystem::file_writer writer(filename, true, 0);
+        REQUIRE_EQ(writer.is_open(), true);
+        REQUIRE_EQ(writer.buffer_size(), mtl::filesystem::file_writer::default_buffer_size);
+        std::vector<std::string> lines { "R", "G", "B" };
+        writer.write_lines(lines.begin(), lines.end());
+        // the destructor writes the remaining data to the file
+    }
+
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "R\nG\nB\n"), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::file_writer flush and close with sync")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::file_writer writer;
+    // syncing when no file is open does nothing
+    writer.flush(true);
+    writer.close(true);
+
+    REQUIRE_EQ(writer.open(filename), true);
+    writer.write_line(text1);
+    writer.flush(true);
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "\n"), true);
+
+    writer.write(text2);
+    writer.close(true);
+    REQUIRE_EQ(writer.is_open(), false);
+
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "\n" + text2), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::file_writer move constructor and move assignment")
+{
+    filename_generator fname_generator;
+    const std::string filename1 = fname_generator.generate_filename();
+    const std::string filename2 = fname_generator.generate_filename();
+
+    // delete the files used for this test case if they exist from a previous failed run
+    std::filesystem::remove(filename1);
+    std::filesystem::remove(filename2);
+
+    REQUIRE_EQ(std::is_copy_constructible_v<mtl::filesystem::file_writer>, false);
+    REQUIRE_EQ(std::is_copy_assignable_v<mtl::filesystem::file_writer>, false);
+
+    mtl::filesystem::file_writer writer1(filename1);
+    writer1.write(text1);
+
+    // moving keeps the data that haven't been written yet
+    mtl::filesystem::file_writer writer2(std::move(writer1));
+    REQUIRE_EQ(writer1.is_open(), false);
+    REQUIRE_EQ(writer2.is_open(), true);
+    writer2.write(text2);
+
+    // the file that was open is closed and its data written before taking over the other file
+    mtl::filesystem::file_writer writer3(filename2);
+    writer3.write("abc");
+    writer3 = std::move(writer2);
+    REQUIRE_EQ(writer2.is_open(), false);
+    REQUIRE_EQ(writer3.is_open(), true);
+    writer3.close();
+
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename1, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + text2), true);
+
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename2, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == "abc"), true);
+
+    // delete the files used for this test case
+    std::filesystem::remove(filename1);
+    std::filesystem::remove(filename2);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::close
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::is_open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::write
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::write_line
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::async_file_writer::flush
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::async_file_writer write, flush and close")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    REQUIRE_EQ(std::is_copy_constructible_v<mtl::filesystem::async_file_writer>, false);
+    REQUIRE_EQ(std::is_move_constructible_v<mtl::filesystem::async_file_writer>, false);
+
+    mtl::filesystem::async_file_writer writer;
+    REQUIRE_EQ(writer.is_open(), false);
+    // writing or flushing when no file is open fails
+    REQUIRE_EQ(writer.write(text1), false);
+    REQUIRE_EQ(writer.flush(), false);
+    REQUIRE_EQ(writer.close(), true);
+
+    REQUIRE_EQ(writer.open(filename), true);
+    REQUIRE_EQ(writer.is_open(), true);
+    REQUIRE_EQ(writer.write(text1), true);
+    REQUIRE_EQ(writer.write_line(text2), true);
+
+    // after flushing all the data are in the file
+    REQUIRE_EQ(writer.flush(), true);
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + text2 + "\n"), true);
+
+    REQUIRE_EQ(writer.write("abc"), true);
+    REQUIRE_EQ(writer.close(), true);
+    REQUIRE_EQ(writer.is_open(), false);
+    REQUIRE_EQ(writer.write(text1), false);
+
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + text2 + "\nabc"), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::async_file_writer flush and close with sync")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::async_file_writer writer;
+    // syncing when no file is open fails
+    REQUIRE_EQ(writer.flush(true), false);
+    REQUIRE_EQ(writer.close(true), true);
+
+    REQUIRE_EQ(writer.open(filename), true);
+    REQUIRE_EQ(writer.write_line(text1), true);
+    REQUIRE_EQ(writer.flush(true), true);
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "\n"), true);
+
+    REQUIRE_EQ(writer.write(text2), true);
+    REQUIRE_EQ(writer.close(true), true);
+    REQUIRE_EQ(writer.is_open(), false);
+
+    read_data.clear();
+    read_correctly = mtl::filesystem::read_file(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "\n" + text2), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+// Windows doesn't allow renaming a file while it is open.
+#if !defined(_WIN32)
+TEST_CASE("mtl::filesystem::async_file_writer sync after the file is renamed")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+    const std::string renamed = fname_generator.generate_filename();
+
+    // delete the files used for this test case if they exist from a previous failed run
+    std::filesystem::remove(filename);
+    std::filesystem::remove(renamed);
+
+    mtl::filesystem::async_file_writer writer(filename);
+    REQUIRE_EQ(writer.write_line(text1), true);
+    std::filesystem::rename(filename, renamed);
+
+    // the open file is synced, not whatever file is found at the path it was opened with
+    REQUIRE_EQ(writer.flush(true), true);
+    REQUIRE_EQ(writer.write(text2), true);
+    REQUIRE_EQ(writer.close(true), true);
+    REQUIRE_EQ(std::filesystem::exists(filename), false);
+
+    std::string read_data;
+    bool read_correctly = mtl::filesystem::read_file(renamed, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == text1 + "\n" + text2), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(renamed);
+}
+#endif // _WIN32 end
+
+TEST_CASE("mtl::filesystem::async_file_writer with append and small queue")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    bool written_correctly = mtl::filesystem::write_file(filename, text1 + "\n");
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<std::string> desired { text1 };
+    {
+        // the queue is smaller than the data so writing has to wait for the background thread
+        mtl::filesystem::async_file_writer writer(filename, true, 16);
+        REQUIRE_EQ(writer.is_open(), true);
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            const std::string line = std::to_string(i) + text2;
+            REQUIRE_EQ(writer.write_line(line), true);
+            desired.emplace_back(line);
+        }
+        // the destructor writes all the queued data
+    }
+
+    std::vector<std::string> read_data;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == desired), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::async_file_writer with multiple threads writing")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::async_file_writer writer(filename, false, 0);
+    REQUIRE_EQ(writer.is_open(), true);
+
+    const size_t lines_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&writer, thread]()
+        {
+            for (size_t i = 0; i < lines_per_thread; ++i)
+            {
+                writer.write_line(std::to_string(thread) + "-" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE_EQ(writer.close(), true);
+
+    // each line is written whole and the lines of each thread keep their order
+    std::vector<std::string> read_data;
+    bool read_correctly = mtl::filesystem::read_all_lines(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(read_data.size(), 4 * lines_per_thread);
+    std::vector<size_t> next_line(4, 0);
+    for (const auto& line : read_data)
+    {
+        const size_t thread = static_cast<size_t>(line[0] - '0');
+        REQUIRE_LT(thread, 4);
+        REQUIRE_EQ((line == std::to_string(thread) + "-" + std::to_string(next_line[thread])),
+                   true);
+        ++next_line[thread];
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::write_binary and mtl::filesystem::read_binary
+// ------------------------------------------------------------------------------------------------
+
+// A trivially copyable type used to test binary files.
+struct binary_point
+{
+    double x = 0.0;
+    double y = 0.0;
+    int id = 0;
+};
+
+TEST_CASE("mtl::filesystem::write_binary and mtl::filesystem::read_binary with doubles")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    std::vector<double> numbers;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        numbers.push_back(static_cast<double>(i) * 1.5 - 100.25);
+    }
+
+    bool written_correctly = mtl::filesystem::write_binary(filename, numbers);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ(std::filesystem::file_size(filename), 32 + (numbers.size() * sizeof(double)));
+
+    // the output is replaced by the contents of the file
+    std::vector<double> read_data { 1.0, 2.0 };
+    bool read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_data == numbers), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::write_binary and mtl::filesystem::read_binary with structs")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::array<binary_point, 3> points
+    {{ { 1.5, 2.5, 1 }, { -3.0, 4.0, 2 }, { 0.0, 100.75, 3 } }};
+
+    // write using a pointer and a count
+    bool written_correctly = mtl::filesystem::write_binary(filename, points.data(), points.size());
+    REQUIRE_EQ(written_correctly, true);
+
+    std::vector<binary_point> read_data;
+    bool read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(read_data.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE_EQ(read_data[i].x, points[i].x);
+        REQUIRE_EQ(read_data[i].y, points[i].y);
+        REQUIRE_EQ(read_data[i].id, points[i].id);
+    }
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::write_binary and mtl::filesystem::read_binary with no elements")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    const std::vector<int> empty;
+    bool written_correctly = mtl::filesystem::write_binary(filename, empty);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ(std::filesystem::file_size(filename), 32);
+
+    std::vector<int> read_data { 1, 2, 3 };
+    bool read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(read_data.empty(), true);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::read_binary with invalid files")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    // a non-existent file
+    std::vector<int> read_data;
+    bool read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, false);
+
+    // a text file
+    bool written_correctly = mtl::filesystem::write_file(filename, text1);
+    REQUIRE_EQ(written_correctly, true);
+    read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, false);
+
+    // a file smaller than the header
+    written_correctly = mtl::filesystem::write_file(filename, "MTLB");
+    REQUIRE_EQ(written_correctly, true);
+    read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, false);
+
+    // reading elements of a different size than the ones written
+    const std::vector<int> numbers { 1, 2, 3, 4 };
+    written_correctly = mtl::filesystem::write_binary(filename, numbers);
+    REQUIRE_EQ(written_correctly, true);
+    std::vector<double> wrong_type;
+    read_correctly = mtl::filesystem::read_binary(filename, wrong_type);
+    REQUIRE_EQ(read_correctly, false);
+    REQUIRE_EQ(wrong_type.empty(), true);
+
+    // a file that is missing some of its elements
+    std::string file_data;
+    read_correctly = mtl::filesystem::read_file(filename, file_data);
+    REQUIRE_EQ(read_correctly, true);
+    file_data.pop_back();
+    written_correctly = mtl::filesystem::write_file(filename, file_data);
+    REQUIRE_EQ(written_correctly, true);
+    read_correctly = mtl::filesystem::read_binary(filename, read_data);
+    REQUIRE_EQ(read_correctly, false);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::close
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::is_open
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::data
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::size
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::empty
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::begin
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::mapped_binary::end
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::mapped_binary with mtl::filesystem::write_binary")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    std::vector<binary_point> points;
+    for (int i = 0; i < 500; ++i)
+    {
+        points.push_back({ static_cast<double>(i) / 4.0, static_cast<double>(-i), i });
+    }
+    bool written_correctly = mtl::filesystem::write_binary(filename, points);
+    REQUIRE_EQ(written_correctly, true);
+
+    mtl::filesystem::mapped_binary<binary_point> view;
+    REQUIRE_EQ(view.is_open(), false);
+    REQUIRE_EQ(view.empty(), true);
+    REQUIRE_EQ(view.open(filename), true);
+    REQUIRE_EQ(view.is_open(), true);
+    REQUIRE_EQ(view.size(), points.size());
+    REQUIRE_EQ(view.empty(), false);
+    REQUIRE_EQ((view.end() - view.begin()), 500);
+
+    size_t index = 0;
+    for (const auto& point : view)
+    {
+        REQUIRE_EQ(point.x, points[index].x);
+        REQUIRE_EQ(point.y, points[index].y);
+        REQUIRE_EQ(view[index].id, points[index].id);
+        ++index;
+    }
+
+    // moving keeps the elements valid
+    mtl::filesystem::mapped_binary<binary_point> other(std::move(view));
+    REQUIRE_EQ(view.is_open(), false);
+    REQUIRE_EQ(view.size(), 0);
+    REQUIRE_EQ(other.size(), points.size());
+    REQUIRE_EQ(other.data()[499].id, 499);
+
+    view = std::move(other);
+    REQUIRE_EQ(other.is_open(), false);
+    REQUIRE_EQ(view[250].id, 250);
+
+    view.close();
+    REQUIRE_EQ(view.is_open(), false);
+    REQUIRE_EQ(view.data(), nullptr);
+
+    // delete the file used for this test case
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("mtl::filesystem::mapped_binary with invalid files")
+{
+    filename_generator fname_generator;
+    const std::string filename = fname_generator.generate_filename();
+
+    // delete the file used for this test case if it exists from a previous failed run
+    std::filesystem::remove(filename);
+
+    mtl::filesystem::mapped_binary<int> view(filename);
+    REQUIRE_EQ(view.is_open(), false);
+
+    // an empty file
+    bool written_correctly = mtl::filesystem::write_file(filename, std::string());
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ(view.open(filename), false);
+    REQUIRE_EQ(view.is_open(), false);
+
+    // elements of a different size than the ones written
+    const std::vector<double> numbers { 1.0, 2.0 };
+    written_correctly = mtl::filesystem::write_binary(filename, numbers);
+    REQUIRE_EQ(written_correctly, true);
+    REQUIRE_EQ(view.open(filename), false);
+    REQUIRE_EQ(view.is_open(), false);
+
+    mtl::filesystem::mapped_binary<double> correct_view(filename);
+    REQUIRE_EQ(correct_view.is_open(), true);
+    REQUIRE_EQ(correct_view[1], 2.0);
+
+    // delete the file used for this test case
+    correct_view.close();
+    std::filesystem::remove(filename);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::filesystem::read_files_par
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::filesystem::read_files_par with files and non-existent files")
+{
+    filename_generator fname_generator;
+    std::vector<std::filesystem::path> filenames;
+    std::vector<std::string> contents;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const std::string filename = fname_generator.generate_filename();
+        // delete the file used for this test case if it exists from a previous failed run
+        std::filesystem::remove(filename);
+
+        filenames.emplace_back(filename);
+        // every fifth file doesn't exist and every seventh file is empty
+        if ((i % 5) == 4)
+        {
+            contents.emplace_back();
+            continue;
+        }
+        std::string text;
+        if ((i % 7) != 0)
+        {
+            text = std::to_string(i) + text1 + "\n" + text2;
+        }
+        bool written_correctly = mtl::filesystem::write_file(filename, text);
+        REQUIRE_EQ(written_correctly, true);
+        contents.emplace_back(text);
+    }
+
+    // the result has to be the same no matter how many threads are used
+    for (size_t threads = 0; threads < 6; ++threads)
+    {
+        std::vector<std::string> read_data { text1 };
+        std::vector<bool> read_success;
+        bool read_correctly = mtl::filesystem::read_files_par(filenames, read_data, read_success,
+                                                              threads);
+        REQUIRE_EQ(read_correctly, false);
+        REQUIRE_EQ(read_data.size(), filenames.size());
+        REQUIRE_EQ(read_success.size(), filenames.size());
+        for (size_t i = 0; i < filenames.size(); ++i)
+        {
+            REQUIRE_EQ(read_success[i], ((i % 5) != 4));
+            REQUIRE_EQ((read_data[i] == contents[i]), true);
+        }
+    }
+
+    // when all files exist the result is true
+    std::vector<std::filesystem::path> existing { filenames[0], filenames[1], filenames[2] };
+    std::vector<std::string> read_data;
+    std::vector<bool> read_success;
+    bool read_correctly = mtl::filesystem::read_files_par(existing, read_data, read_success, 8);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ((read_success == std::vector<bool> { true, true, true }), true);
+    REQUIRE_EQ((read_data[2] == contents[2]), true);
+
+    // no files to read
+    existing.clear();
+    read_correctly = mtl::filesystem::read_files_par(existing, read_data, read_success);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(read_data.empty(), true);
+    REQUIRE_EQ(read_success.empty(), true);
+
+    // delete the files used for this test case
+    for (const auto& filename : filenames)
+    {
+        std::filesystem::remove(filename);
+    }
+}
+
+TEST_CASE("mtl::filesystem::read_files_par with directory and filter")
+{
+    filename_generator fname_generator;
+    const std::filesystem::path directory = fname_generator.generate_filename();
+
+    // delete the directory used for this test case if it exists from a previous failed run
+    std::filesystem::remove_all(directory);
+
+    std::vector<std::filesystem::path> filenames;
+    std::vector<std::string> read_data;
+    std::vector<bool> read_success;
+
+    // a directory that doesn't exist
+    auto filter = [](const std::filesystem::path& path) { return path.extension() == ".cfg"; };
+    bool read_correctly = mtl::filesystem::read_files_par(directory, filter, filenames,
+                                                          read_data, read_success);
+    REQUIRE_EQ(read_correctly, false);
+    REQUIRE_EQ(filenames.empty(), true);
+    REQUIRE_EQ(read_data.empty(), true);
+
+    std::filesystem::create_directory(directory);
+    // a subdirectory that matches the filter but isn't searched or read
+    std::filesystem::create_directory(directory / "sub.cfg");
+    for (size_t i = 0; i < 20; ++i)
+    {
+        const std::string name = "file" + std::to_string(i + 10);
+        bool written_correctly = mtl::filesystem::write_file(directory / (name + ".cfg"), name);
+        REQUIRE_EQ(written_correctly, true);
+        written_correctly = mtl::filesystem::write_file(directory / (name + ".txt"), text1);
+        REQUIRE_EQ(written_correctly, true);
+    }
+
+    read_correctly = mtl::filesystem::read_files_par(directory, filter, filenames, read_data,
+                                                     read_success, 4);
+    REQUIRE_EQ(read_correctly, true);
+    REQUIRE_EQ(filenames.size(), 20);
+    REQUIRE_EQ(read_data.size(), 20);
+    REQUIRE_EQ(read_success.size(), 20);
+    // the files are sorted by name
+    for (size_t i = 0; i < filenames.size(); ++i)
+    {
+        const std::string name = "file" + std::to_string(i + 10);
+        REQUIRE_EQ((filenames[i].filename() == (name + ".cfg")), true);
+        REQUIRE_EQ((read_data[i] == name), true);
+        REQUIRE_EQ(read_success[i], true);
+    }
+
+    // delete the directory used for this test case
+    std::filesystem::remove_all(directory);
+}
+
+
+
+
 TEST_CASE("Tests with different encoding depending on OS, write_file and read_file")
 {
 
@@ -12,6 +12,13 @@
 #include <set>
 #include <utility>   // std::pair
 #include <stdexcept> // std::invalid_argument, std::logic_error
+#include <string_view> // std::string_view
+#include <iterator>  // std::distance, std::next
+#include <algorithm> // std::equal
+#include <array>     // std::array
+#include <limits>    // std::numeric_limits
+#include <cstdint>   // int8_t, uint8_t, int64_t, uint64_t
+#include <sstream>   // std::ostringstream
 
 // Disable some asserts so we can test more thoroughly.
 #define MTL_DISABLE_SOME_ASSERTS
@@ -19,11 +26,28 @@
 
 #include "../mtl/string.hpp"
 // mtl::string::is_upper, mtl::string::is_lower, mtl::string::to_upper, mtl::string::to_lower,
-// mtl::string::is_ascii, mtl::string::is_alphabetic, mtl::string::is_numeric, 
-// mtl::string::is_alphanum,  mtl::string::contains, mtl::string::strip_front, 
+// mtl::string::is_ascii, mtl::string::is_alphabetic, mtl::string::is_numeric,
+// mtl::string::is_alphanum, mtl::string::contains, mtl::string::strip_front,
 // mtl::string::strip_back, mtl::string::strip, mtl::string::pad_front, mtl::string::pad_back,
 // mtl::string::pad, mtl::string::to_string, mtl::string::join_all, mtl::string::join,
-// mtl::string::split, mtl::string::replace, mtl::string::replace_all
+// mtl::string::split, mtl::string::replace, mtl::string::replace_all,
+// [@class] mtl::string::split_view, mtl::string::split_view::begin, mtl::string::split_view::end,
+// mtl::string::split_view::empty, mtl::string::split_any, [@class] mtl::string::replacer,
+// mtl::string::replacer::size, mtl::string::replacer::replace, [@class] mtl::string::searcher,
+// mtl::string::searcher::match, mtl::string::searcher::size, mtl::string::searcher::find,
+// mtl::string::searcher::contains, mtl::string::searcher::count, mtl::string::replace_copy,
+// mtl::string::strip_front_view, mtl::string::strip_back_view, mtl::string::strip_view,
+// mtl::string::equals_ignore_case, mtl::string::starts_with_ignore_case,
+// mtl::string::ends_with_ignore_case, mtl::string::find_ignore_case,
+// mtl::string::contains_ignore_case, mtl::string::replace_ignore_case, mtl::string::join_all_par,
+// [@class] mtl::string::arena, mtl::string::arena::allocate, mtl::string::arena::reset,
+// mtl::string::arena::block_count, [@class] mtl::string::builder, mtl::string::builder::size,
+// mtl::string::builder::empty, mtl::string::builder::capacity, mtl::string::builder::data,
+// mtl::string::builder::view, mtl::string::builder::reserve, mtl::string::builder::clear,
+// mtl::string::builder::append, mtl::string::builder::push_back, mtl::string::builder::release,
+// mtl::string::pad_front_all, mtl::string::pad_back_all, mtl::string::pad_all,
+// mtl::string::strip_front_any, mtl::string::strip_back_any, mtl::string::strip_any,
+// mtl::string::strip_front_any_view, mtl::string::strip_back_any_view, mtl::string::strip_any_view
 
 
 
@@ -1045,6 +1069,90 @@ TEST_CASE("mtl::string::is_alphanum")
     CHECK_EQ(mtl::string::is_alphanum(mixed_nonascii), false);
 }
 
+TEST_CASE("mtl::string::is_upper, is_lower, is_ascii, is_alphabetic, is_numeric, is_alphanum "
+          "with std::string_view")
+{
+    // views to parts of a larger std::string without any copies
+    const std::string text = "ABCdef123 ";
+    const std::string_view upper(text.data(), 3);
+    const std::string_view lower(text.data() + 3, 3);
+    const std::string_view numbers(text.data() + 6, 3);
+    const std::string_view alphanum(text.data(), 9);
+
+    CHECK_EQ(mtl::string::is_upper(upper), true);
+    CHECK_EQ(mtl::string::is_upper(lower), false);
+    CHECK_EQ(mtl::string::is_lower(lower), true);
+    CHECK_EQ(mtl::string::is_lower(upper), false);
+    CHECK_EQ(mtl::string::is_ascii(std::string_view(text)), true);
+    CHECK_EQ(mtl::string::is_ascii(std::string_view(smiley)), false);
+    CHECK_EQ(mtl::string::is_alphabetic(std::string_view(text.data(), 6)), true);
+    CHECK_EQ(mtl::string::is_alphabetic(alphanum), false);
+    CHECK_EQ(mtl::string::is_numeric(numbers), true);
+    CHECK_EQ(mtl::string::is_numeric(alphanum), false);
+    CHECK_EQ(mtl::string::is_alphanum(alphanum), true);
+    CHECK_EQ(mtl::string::is_alphanum(std::string_view(text)), false);
+
+    // works with string literals without creating an std::string
+    CHECK_EQ(mtl::string::is_upper("ABC"), true);
+    CHECK_EQ(mtl::string::is_numeric("12a"), false);
+}
+
+TEST_CASE("mtl::string::to_upper, to_lower, is_upper, is_lower, is_ascii, is_alphabetic, "
+          "is_numeric, is_alphanum with long std::string")
+{
+    // long enough strings so characters are processed both many at a time and one at a time,
+    // every possible character is placed in many positions and the result is compared with the
+    // result of the version for a single character
+    const std::vector<std::string> bases { std::string(70, 'A'), std::string(70, 'a'),
+                                           std::string(70, '5'), std::string(70, '~') };
+    for (const auto& base : bases)
+    {
+        const char base_char = base[0];
+        bool same_results = true;
+        for (size_t position = 0; position < base.size(); position += 3)
+        {
+            for (int value = 0; value < 256; ++value)
+            {
+                std::string input = base;
+                const auto character = static_cast<char>(value);
+                input[position] = character;
+
+                if ((mtl::string::is_upper(input) != (mtl::string::is_upper(base_char) &&
+                                                      mtl::string::is_upper(character))) ||
+                    (mtl::string::is_lower(input) != (mtl::string::is_lower(base_char) &&
+                                                      mtl::string::is_lower(character))) ||
+                    (mtl::string::is_ascii(input) != mtl::string::is_ascii(character)) ||
+                    (mtl::string::is_alphabetic(input) != (mtl::string::is_alphabetic(base_char) &&
+                                                    mtl::string::is_alphabetic(character))) ||
+                    (mtl::string::is_numeric(input) != (mtl::string::is_numeric(base_char) &&
+                                                        mtl::string::is_numeric(character))) ||
+                    (mtl::string::is_alphanum(input) != (mtl::string::is_alphanum(base_char) &&
+                                                         mtl::string::is_alphanum(character))))
+                {
+                    same_results = false;
+                }
+
+                std::string upper = input;
+                mtl::string::to_upper(upper);
+                std::string lower = input;
+                mtl::string::to_lower(lower);
+                for (size_t i = 0; i < input.size(); ++i)
+                {
+                    char upper_char = input[i];
+                    mtl::string::to_upper(upper_char);
+                    char lower_char = input[i];
+                    mtl::string::to_lower(lower_char);
+                    if ((upper[i] != upper_char) || (lower[i] != lower_char))
+                    {
+                        same_results = false;
+                    }
+                }
+            }
+        }
+        CHECK_EQ(same_results, true);
+    }
+}
+
 // -----------------------------------------------------------------------------------------------
 // mtl::string::contains
 // -----------------------------------------------------------------------------------------------
@@ -1344,6 +1452,299 @@ TEST_CASE("mtl::string::contains, const char* / char")
 
 }
 
+TEST_CASE("mtl::string::contains, std::string / std::string with long std::string")
+{
+    // matches at every position of an input long enough to be searched many characters at a time
+    std::string long_text(100, 'a');
+    for (size_t i = 0; i < 90; ++i)
+    {
+        std::string text = long_text;
+        text.replace(i, 10, "needle_end");
+        CHECK_EQ(mtl::string::contains(text, std::string("needle_end")), true);
+        CHECK_EQ(mtl::string::contains(text, std::string("needle_enx")), false);
+    }
+
+    // repetitive input where the first and last characters of the match are found often
+    std::string repetitive;
+    for (size_t i = 0; i < 50; ++i) { repetitive += "abcabcabd"; }
+    CHECK_EQ(mtl::string::contains(repetitive, std::string("abcabcabc")), false);
+    CHECK_EQ(mtl::string::contains(repetitive, std::string("abdabcabcabd")), true);
+    repetitive += "abcabcabc";
+    CHECK_EQ(mtl::string::contains(repetitive, std::string("abcabcabc")), true);
+}
+
+TEST_CASE("mtl::string::contains, std::string_view / std::string_view")
+{
+    // a view that isn't null terminated so the match after the view isn't found
+    const std::string text = "Hello world";
+    const std::string_view hello(text.data(), 5);
+    CHECK_EQ(mtl::string::contains(hello, std::string_view("ell")), true);
+    CHECK_EQ(mtl::string::contains(hello, std::string_view("world")), false);
+    CHECK_EQ(mtl::string::contains(hello, std::string_view("o w")), false);
+    CHECK_EQ(mtl::string::contains(hello, std::string_view()), true);
+    CHECK_EQ(mtl::string::contains(hello, "Hell"), true);
+    CHECK_EQ(mtl::string::contains(hello, text), false);
+    CHECK_EQ(mtl::string::contains(text, hello), true);
+    CHECK_EQ(mtl::string::contains(hello, 'o'), true);
+    CHECK_EQ(mtl::string::contains(hello, 'w'), false);
+    CHECK_EQ(mtl::string::contains(std::string_view(), 'w'), false);
+}
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher::match
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher::size
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher::find
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher::contains
+// ------------------------------------------------------------------------------------------------
+// mtl::string::searcher::count
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::searcher")
+{
+    const mtl::string::searcher needle_searcher("needle");
+    CHECK_EQ(needle_searcher.match(), std::string("needle"));
+    CHECK_EQ(needle_searcher.size(), 6);
+
+    const std::string text = "a needle in a haystack with another needle";
+    CHECK_EQ(needle_searcher.find(text), 2);
+    CHECK_EQ(needle_searcher.find(text, 2), 2);
+    CHECK_EQ(needle_searcher.find(text, 3), 36);
+    CHECK_EQ(needle_searcher.find(text, 37), std::string_view::npos);
+    CHECK_EQ(needle_searcher.find(text, 1000), std::string_view::npos);
+    CHECK_EQ(needle_searcher.contains(text), true);
+    CHECK_EQ(needle_searcher.contains("haystack"), false);
+    CHECK_EQ(needle_searcher.contains(""), false);
+    CHECK_EQ(needle_searcher.contains("needl"), false);
+    CHECK_EQ(needle_searcher.count(text), 2);
+    CHECK_EQ(needle_searcher.count("haystack"), 0);
+
+    // count doesn't count overlapping matches
+    const mtl::string::searcher aa_searcher("aa");
+    CHECK_EQ(aa_searcher.count("aaaaa"), 2);
+
+    // with a single character
+    const mtl::string::searcher char_searcher("k");
+    CHECK_EQ(char_searcher.find(text), 21);
+    CHECK_EQ(char_searcher.count(text), 1);
+
+    // default constructed and empty searchers find the empty substring at the start
+    const mtl::string::searcher empty_searcher;
+    CHECK_EQ(empty_searcher.size(), 0);
+    CHECK_EQ(empty_searcher.find(text), 0);
+    CHECK_EQ(empty_searcher.find(text, 5), 5);
+    CHECK_EQ(empty_searcher.find(""), 0);
+    CHECK_EQ(empty_searcher.contains(text), true);
+    CHECK_EQ(empty_searcher.count(text), 0);
+}
+
+TEST_CASE("mtl::string::searcher gives the same results as std::string::find")
+{
+    // inputs and matches of various sizes so matches are found both by the parts that check
+    // many characters at a time and the parts that check one character at a time
+    std::string input;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        input += static_cast<char>('a' + static_cast<char>((i * 7) % 3));
+    }
+    input += "xaaaaaaaaaaaaaaaaaaay";
+
+    const std::vector<std::string> matches { "a", "ab", "ba", "cab", "abcabc", "aaaa", "aaaay",
+                                             "xaaaaaaaaaaaaaaaaaaay", "caaaaaaaa", "bcab", "z",
+                                             "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaay" };
+    for (const auto& match : matches)
+    {
+        const mtl::string::searcher match_searcher(match);
+        for (size_t size = 0; size <= input.size(); size += 7)
+        {
+            const std::string_view text(input.data(), size);
+            for (size_t position = 0; position <= size; position += 3)
+            {
+                CHECK_EQ(match_searcher.find(text, position), text.find(match, position));
+            }
+        }
+    }
+}
+
+TEST_CASE("mtl::string::searcher with characters outside of ASCII")
+{
+    const mtl::string::searcher utf8_searcher("κείμενο");
+    const std::string utf8_text = "Ελληνικά κείμενο και 文字";
+    CHECK_EQ(utf8_searcher.find(utf8_text), utf8_text.find("κείμενο"));
+    CHECK_EQ(utf8_searcher.contains(utf8_text), true);
+    CHECK_EQ(utf8_searcher.contains("文字"), false);
+}
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::equals_ignore_case
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::equals_ignore_case")
+{
+    CHECK_EQ(mtl::string::equals_ignore_case("Hello World", "hELLO wORLD"), true);
+    CHECK_EQ(mtl::string::equals_ignore_case("Hello World", "Hello World"), true);
+    CHECK_EQ(mtl::string::equals_ignore_case("Hello World", "Hello World!"), false);
+    CHECK_EQ(mtl::string::equals_ignore_case("Hello World", "Hello Wordl"), false);
+    CHECK_EQ(mtl::string::equals_ignore_case("", ""), true);
+    CHECK_EQ(mtl::string::equals_ignore_case("", "a"), false);
+
+    // only letters differ by case, the characters 32 positions apart that aren't letters differ
+    CHECK_EQ(mtl::string::equals_ignore_case("@[`{", "`{@["), false);
+    CHECK_EQ(mtl::string::equals_ignore_case("123 _-", "123 _-"), true);
+
+    // characters outside of ASCII are compared exactly
+    CHECK_EQ(mtl::string::equals_ignore_case("Ελληνικά", "Ελληνικά"), true);
+    CHECK_EQ(mtl::string::equals_ignore_case("Ελληνικά", "ελληνικά"), false);
+
+    // long enough strings so characters are compared many at a time, with every possible
+    // character in many positions
+    const std::string upper(70, 'Q');
+    const std::string lower(70, 'q');
+    CHECK_EQ(mtl::string::equals_ignore_case(upper, lower), true);
+    bool same_results = true;
+    for (size_t position = 0; position < upper.size(); position += 5)
+    {
+        for (int value = 0; value < 256; ++value)
+        {
+            std::string input = upper;
+            input[position] = static_cast<char>(value);
+            const bool desired = (value == 'Q') || (value == 'q');
+            if (mtl::string::equals_ignore_case(input, lower) != desired)
+            {
+                same_results = false;
+            }
+        }
+    }
+    CHECK_EQ(same_results, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::starts_with_ignore_case, mtl::string::ends_with_ignore_case
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::starts_with_ignore_case and mtl::string::ends_with_ignore_case")
+{
+    const std::string text = "Content-Type: text/HTML";
+    CHECK_EQ(mtl::string::starts_with_ignore_case(text, "content-type"), true);
+    CHECK_EQ(mtl::string::starts_with_ignore_case(text, "CONTENT-TYPE:"), true);
+    CHECK_EQ(mtl::string::starts_with_ignore_case(text, "content-length"), false);
+    CHECK_EQ(mtl::string::starts_with_ignore_case(text, ""), true);
+    CHECK_EQ(mtl::string::starts_with_ignore_case(text, text + " "), false);
+    CHECK_EQ(mtl::string::ends_with_ignore_case(text, "text/html"), true);
+    CHECK_EQ(mtl::string::ends_with_ignore_case(text, ".HTML"), false);
+    CHECK_EQ(mtl::string::ends_with_ignore_case(text, ""), true);
+    CHECK_EQ(mtl::string::ends_with_ignore_case(text, " " + text), false);
+    CHECK_EQ(mtl::string::starts_with_ignore_case("", ""), true);
+    CHECK_EQ(mtl::string::ends_with_ignore_case("", "a"), false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::find_ignore_case, mtl::string::contains_ignore_case
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::find_ignore_case and mtl::string::contains_ignore_case")
+{
+    const std::string text = "A Needle in a haystack with another NEEDLE";
+    CHECK_EQ(mtl::string::find_ignore_case(text, "needle"), 2);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "NEEDLE", 3), 36);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "needle", 37), std::string_view::npos);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "needle", 1000), std::string_view::npos);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "HAYSTACK"), 14);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "k"), 21);
+    CHECK_EQ(mtl::string::find_ignore_case(text, ""), 0);
+    CHECK_EQ(mtl::string::find_ignore_case(text, "", 5), 5);
+    CHECK_EQ(mtl::string::find_ignore_case("", "a"), std::string_view::npos);
+    CHECK_EQ(mtl::string::contains_ignore_case(text, "aNoThEr"), true);
+    CHECK_EQ(mtl::string::contains_ignore_case(text, "thread"), false);
+    CHECK_EQ(mtl::string::contains_ignore_case("Ελληνικά κείμενο", "κείμενο"), true);
+
+    // gives the same results as std::string::find on text converted to lowercase, with inputs
+    // long enough to be searched many characters at a time
+    std::string input;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        const auto letter = static_cast<char>('a' + static_cast<char>((i * 7) % 3));
+        if ((i % 5) == 0) { input += static_cast<char>(letter - 32); }
+        else { input += letter; }
+    }
+    input += "XaAaAaAaAaAaAaAaAaAaY";
+    std::string lower_input = input;
+    mtl::string::to_lower(lower_input);
+
+    const std::vector<std::string> matches { "a", "Ab", "BA", "cAB", "abcABC", "aaaa", "AAAAY",
+                                             "xaaaaaaaaaaaaaaaaaaay", "caaaaaaaa", "z" };
+    bool same_results = true;
+    for (const auto& match : matches)
+    {
+        std::string lower_match = match;
+        mtl::string::to_lower(lower_match);
+        for (size_t size = 0; size <= input.size(); size += 7)
+        {
+            const std::string_view text_view(input.data(), size);
+            const std::string_view lower_view(lower_input.data(), size);
+            for (size_t position = 0; position <= size; position += 3)
+            {
+                if (mtl::string::find_ignore_case(text_view, match, position) !=
+                    lower_view.find(lower_match, position))
+                {
+                    same_results = false;
+                }
+            }
+        }
+    }
+    CHECK_EQ(same_results, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::replace_ignore_case
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::replace_ignore_case")
+{
+    std::string text = "Cat, cat, CAT and cAt.";
+    CHECK_EQ(mtl::string::replace_ignore_case(text, "cat", "dog"), 4);
+    CHECK_EQ(text, std::string("dog, dog, dog and dog."));
+
+    // with a larger and a smaller replacement
+    CHECK_EQ(mtl::string::replace_ignore_case(text, "DOG", "Tiger"), 4);
+    CHECK_EQ(text, std::string("Tiger, Tiger, Tiger and Tiger."));
+    CHECK_EQ(mtl::string::replace_ignore_case(text, "tiger", ""), 4);
+    CHECK_EQ(text, std::string(", ,  and ."));
+
+    // with nothing to replace
+    CHECK_EQ(mtl::string::replace_ignore_case(text, "cat", "dog"), 0);
+    CHECK_EQ(text, std::string(", ,  and ."));
+
+    // with an empty match
+    CHECK_EQ(mtl::string::replace_ignore_case(text, "", "dog"), 0);
+    CHECK_EQ(text, std::string(", ,  and ."));
+
+    // with empty input
+    std::string empty;
+    CHECK_EQ(mtl::string::replace_ignore_case(empty, "cat", "dog"), 0);
+    CHECK_EQ(empty.empty(), true);
+
+    // with matches next to each other and a long std::string
+    std::string long_text;
+    std::string long_result;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        long_text += "aAAa";
+        long_result += "bb";
+    }
+    CHECK_EQ(mtl::string::replace_ignore_case(long_text, "AA", "b"), 200);
+    CHECK_EQ(long_text, long_result);
+}
+
 
 
 
@@ -1581,6 +1982,148 @@ TEST_CASE("mtl::string::strip")
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// mtl::string::strip_front_view, mtl::string::strip_back_view, mtl::string::strip_view
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::strip_front_view, mtl::string::strip_back_view, mtl::string::strip_view")
+{
+    const std::string john = "  John  ";
+    const std::string_view front = mtl::string::strip_front_view(john);
+    const std::string_view back = mtl::string::strip_back_view(john);
+    const std::string_view both = mtl::string::strip_view(john);
+    CHECK_EQ(front, std::string_view("John  "));
+    CHECK_EQ(back, std::string_view("  John"));
+    CHECK_EQ(both, std::string_view("John"));
+
+    // the views point inside the input and the input isn't modified
+    CHECK_EQ(front.data(), john.data() + 2);
+    CHECK_EQ(back.data(), john.data());
+    CHECK_EQ(both.data(), john.data() + 2);
+    CHECK_EQ(john, std::string("  John  "));
+
+    // with a different character
+    CHECK_EQ(mtl::string::strip_view("__Mary_________", '_'), std::string_view("Mary"));
+    CHECK_EQ(mtl::string::strip_front_view("rmillrrr", 'r'), std::string_view("millrrr"));
+    CHECK_EQ(mtl::string::strip_back_view("rmillrrr", 'r'), std::string_view("rmill"));
+
+    // where nothing matches
+    CHECK_EQ(mtl::string::strip_view("ABCDEF", '2'), std::string_view("ABCDEF"));
+    CHECK_EQ(mtl::string::strip_view("NNNNN|NNNNN", 'N'), std::string_view("|"));
+
+    // where all characters are removed
+    CHECK_EQ(mtl::string::strip_view("AAAAA", 'A').empty(), true);
+    CHECK_EQ(mtl::string::strip_front_view("AAAAA", 'A').empty(), true);
+    CHECK_EQ(mtl::string::strip_back_view("AAAAA", 'A').empty(), true);
+    CHECK_EQ(mtl::string::strip_view("").empty(), true);
+
+    // gives the same result as mtl::string::strip
+    const std::vector<std::string> inputs { "", " ", "a", " a", "a ", " a ", "  aa  ", "a a" };
+    for (const auto& input : inputs)
+    {
+        std::string stripped = input;
+        mtl::string::strip(stripped);
+        CHECK_EQ(mtl::string::strip_view(input), std::string_view(stripped));
+    }
+
+    // check that is works correctly with UTF8 strings
+    CHECK_EQ(mtl::string::strip_view(smiley_spaces), std::string_view(smiley));
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::strip_front_any, mtl::string::strip_back_any, mtl::string::strip_any
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::strip_front_any, mtl::string::strip_back_any, mtl::string::strip_any")
+{
+    std::string empty;
+    mtl::string::strip_any(empty);
+    CHECK_EQ(empty, std::string());
+
+    std::string only_whitespace = " \t\n\v\f\r \t";
+    mtl::string::strip_any(only_whitespace);
+    CHECK_EQ(only_whitespace, std::string());
+
+    std::string front = " \t\r\n  text with spaces \n";
+    mtl::string::strip_front_any(front);
+    CHECK_EQ(front, std::string("text with spaces \n"));
+
+    std::string back = " \t text with spaces \t\r\n";
+    mtl::string::strip_back_any(back);
+    CHECK_EQ(back, std::string(" \t text with spaces"));
+
+    std::string both = "\t\t  text\twith\ttabs \r\n";
+    mtl::string::strip_any(both);
+    CHECK_EQ(both, std::string("text\twith\ttabs"));
+
+    std::string custom = "-=-=value=-=-";
+    mtl::string::strip_front_any(custom, "=-");
+    CHECK_EQ(custom, std::string("value=-=-"));
+    mtl::string::strip_back_any(custom, std::string("-="));
+    CHECK_EQ(custom, std::string("value"));
+
+    std::string no_set = "  value  ";
+    mtl::string::strip_any(no_set, "");
+    CHECK_EQ(no_set, std::string("  value  "));
+
+    // check that is works correctly with UTF8 strings
+    std::string utf8 = "\t " + smiley + " \n";
+    mtl::string::strip_any(utf8);
+    CHECK_EQ(utf8, smiley);
+}
+
+TEST_CASE("mtl::string::strip_any with long runs and large sets of characters")
+{
+    // a large set of characters is not compared with SIMD
+    const std::string large_set = "0123456789abcdef";
+    // check every size of run on both sides so every combination of SIMD and non-SIMD paths
+    // is used
+    bool all_correct = true;
+    for (size_t front = 0; front < 40; ++front)
+    {
+        for (size_t back = 0; back < 40; ++back)
+        {
+            const std::string middle = "[" + std::string(front % 5, 'x') + "]";
+            const std::string value = std::string(front, ' ') + middle + std::string(back, '\t');
+            std::string stripped = value;
+            mtl::string::strip_any(stripped);
+            all_correct = all_correct && (stripped == middle);
+            all_correct = all_correct && (mtl::string::strip_any_view(value) == middle);
+
+            std::string numbers = std::string(front, '7') + middle + std::string(back, 'e');
+            mtl::string::strip_any(numbers, large_set);
+            all_correct = all_correct && (numbers == middle);
+        }
+    }
+    CHECK_EQ(all_correct, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::strip_front_any_view, mtl::string::strip_back_any_view, mtl::string::strip_any_view
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::strip_front_any_view, mtl::string::strip_back_any_view")
+{
+    CHECK_EQ(mtl::string::strip_any_view(std::string_view()), std::string_view());
+    CHECK_EQ(mtl::string::strip_any_view(" \t\r\n"), std::string_view());
+
+    const std::string value = " \t\r\n key = value \r\n";
+    CHECK_EQ(mtl::string::strip_front_any_view(value), std::string_view("key = value \r\n"));
+    CHECK_EQ(mtl::string::strip_back_any_view(value), std::string_view(" \t\r\n key = value"));
+    CHECK_EQ(mtl::string::strip_any_view(value), std::string_view("key = value"));
+
+    // the view points inside the input without copying it
+    const std::string_view stripped = mtl::string::strip_any_view(value);
+    CHECK_EQ(stripped.data(), value.data() + 5);
+
+    const char* cs = "__--name--__";
+    CHECK_EQ(mtl::string::strip_front_any_view(cs, "_-"), std::string_view("name--__"));
+    CHECK_EQ(mtl::string::strip_back_any_view(cs, "_-"), std::string_view("__--name"));
+    CHECK_EQ(mtl::string::strip_any_view(cs, "-_"), std::string_view("name"));
+    CHECK_EQ(mtl::string::strip_any_view(cs, ""), std::string_view(cs));
+}
+
 // ------------------------------------------------------------------------------------------------
 // mtl::string::pad_front, mtl::string::pad_back, mtl::string::pad
 // ------------------------------------------------------------------------------------------------
@@ -1798,6 +2341,109 @@ TEST_CASE("mtl::string::pad with more_back set to true")
     CHECK_EQ((_smiley == smiley), false);
 }
 
+TEST_CASE("mtl::string::pad_front, mtl::string::pad_back, mtl::string::pad with std::string_view")
+{
+    // only the size of the match is used so a view to part of a string is enough
+    const std::string header = "Column name | Value";
+    const std::string_view column(header.data(), 11);
+
+    std::string front = "Id";
+    mtl::string::pad_front(front, column);
+    CHECK_EQ(front, std::string("         Id"));
+
+    std::string back = "Id";
+    mtl::string::pad_back(back, column, '.');
+    CHECK_EQ(back, std::string("Id........."));
+
+    std::string both = "Id";
+    mtl::string::pad(both, column, '-');
+    CHECK_EQ(both, std::string("-----Id----"));
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::pad_front_all, mtl::string::pad_back_all, mtl::string::pad_all
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::pad_front_all, mtl::string::pad_back_all, mtl::string::pad_all empty")
+{
+    std::vector<std::string> empty;
+    CHECK_EQ(mtl::string::pad_front_all(empty.begin(), empty.end(), 10), std::string());
+    CHECK_EQ(mtl::string::pad_back_all(empty.begin(), empty.end()), std::string());
+    std::string result = "unchanged";
+    mtl::string::pad_all(empty.begin(), empty.end(), result, 5, '-', "|");
+    CHECK_EQ(result, std::string("unchanged"));
+}
+
+TEST_CASE("mtl::string::pad_front_all, mtl::string::pad_back_all, mtl::string::pad_all")
+{
+    std::vector<std::string> cells {"a", "bbb", "", "cccccc", "dd"};
+
+    CHECK_EQ(mtl::string::pad_front_all(cells.begin(), cells.end(), 4, '.', "|"),
+             std::string("...a|.bbb|....|cccccc|..dd"));
+    CHECK_EQ(mtl::string::pad_back_all(cells.begin(), cells.end(), 4, '.', "|"),
+             std::string("a...|bbb.|....|cccccc|dd.."));
+    CHECK_EQ(mtl::string::pad_all(cells.begin(), cells.end(), 4, '.', "|"),
+             std::string("..a.|.bbb|....|cccccc|.dd."));
+    CHECK_EQ(mtl::string::pad_all(cells.begin(), cells.end(), 4, '.', "|", true),
+             std::string(".a..|bbb.|....|cccccc|.dd."));
+
+    // a width of 0 pads to the size of the longest string
+    CHECK_EQ(mtl::string::pad_front_all(cells.begin(), cells.end()),
+             std::string("     a   bbb      cccccc    dd"));
+    CHECK_EQ(mtl::string::pad_back_all(cells.begin(), cells.end(), 0, '_'),
+             std::string("a_____bbb_________ccccccdd____"));
+
+    // the padded strings are appended to what the result already contains
+    std::list<const char*> lcs {"x", "yy", "zzz"};
+    std::string result = "start:";
+    mtl::string::pad_front_all(lcs.begin(), lcs.end(), result, 3, ' ', ", ");
+    CHECK_EQ(result, std::string("start:  x,  yy, zzz"));
+
+    std::vector<std::string_view> vsv {"1", "22", "333"};
+    std::string column;
+    mtl::string::pad_all(vsv.begin(), vsv.end(), column, 0, '*', "\n");
+    CHECK_EQ(column, std::string("*1*\n*22\n333"));
+
+    // every padded string should be the same as padding it on its own
+    std::vector<std::string> many;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        many.emplace_back(i % 37, static_cast<char>('a' + (i % 26)));
+    }
+    std::string desired_front;
+    std::string desired_back;
+    std::string desired_middle;
+    std::string desired_middle_back;
+    for (const auto& cell : many)
+    {
+        std::string front = cell;
+        mtl::string::pad_front(front, std::string(30, ' '), '#');
+        desired_front += front;
+        std::string back = cell;
+        mtl::string::pad_back(back, std::string(30, ' '), '#');
+        desired_back += back;
+        std::string middle = cell;
+        mtl::string::pad(middle, std::string(30, ' '), '#');
+        desired_middle += middle;
+        std::string middle_back = cell;
+        mtl::string::pad(middle_back, std::string(30, ' '), '#', true);
+        desired_middle_back += middle_back;
+    }
+    CHECK_EQ(mtl::string::pad_front_all(many.begin(), many.end(), 30, '#'), desired_front);
+    CHECK_EQ(mtl::string::pad_back_all(many.begin(), many.end(), 30, '#'), desired_back);
+    CHECK_EQ(mtl::string::pad_all(many.begin(), many.end(), 30, '#'), desired_middle);
+    CHECK_EQ(mtl::string::pad_all(many.begin(), many.end(), 30, '#', "", true), 
+             desired_middle_back);
+
+    const char* cs_nullptr = nullptr;
+    std::vector<const char*> vcs_nullptr {"a", cs_nullptr};
+    std::string nullptr_result;
+    REQUIRE_THROWS_AS(nullptr_result = mtl::string::pad_back_all(vcs_nullptr.begin(),
+                                                                 vcs_nullptr.end(), 4),
+                      std::logic_error);
+    REQUIRE_EQ(nullptr_result.empty(), true);
+}
 
 // ------------------------------------------------------------------------------------------------
 // mtl::string::to_string
@@ -1900,6 +2546,171 @@ TEST_CASE("mtl::string::to_string")
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// mtl::string::arena
+// ------------------------------------------------------------------------------------------------
+// mtl::string::arena::allocate
+// ------------------------------------------------------------------------------------------------
+// mtl::string::arena::reset
+// ------------------------------------------------------------------------------------------------
+// mtl::string::arena::block_count
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::arena")
+{
+    mtl::string::arena memory(64);
+    CHECK_EQ(memory.block_count(), 0);
+
+    char* first = memory.allocate(10);
+    char* second = memory.allocate(20);
+    CHECK_EQ(memory.block_count(), 1);
+    CHECK_EQ(second, first + 10);
+
+    // requests that don't fit in the rest of the block start a new block
+    char* third = memory.allocate(40);
+    CHECK_EQ(memory.block_count(), 2);
+    CHECK_NE(third, second + 20);
+
+    // requests larger than the block size get a block of their own
+    char* large = memory.allocate(1000);
+    std::fill(large, large + 1000, 'a');
+    CHECK_EQ(memory.block_count(), 3);
+    CHECK_EQ(std::string(large, 1000), std::string(1000, 'a'));
+
+    memory.reset();
+    CHECK_EQ(memory.block_count(), 1);
+    CHECK_EQ(memory.allocate(10), large);
+
+    mtl::string::arena empty_memory;
+    empty_memory.reset();
+    CHECK_EQ(empty_memory.block_count(), 0);
+
+    REQUIRE_THROWS_AS(mtl::string::arena(0), std::invalid_argument);
+}
+
+TEST_CASE("mtl::string::arena allocate 0 characters")
+{
+    mtl::string::arena memory(64);
+    char* nothing = memory.allocate(0);
+    CHECK_NE(nothing, nullptr);
+    CHECK_EQ(memory.block_count(), 1);
+
+    // allocating 0 characters doesn't use any of the block
+    char* first = memory.allocate(10);
+    CHECK_EQ(first, nothing);
+    CHECK_EQ(memory.allocate(0), first + 10);
+    CHECK_EQ(memory.block_count(), 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::size
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::empty
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::capacity
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::data
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::view
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::reserve
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::clear
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::append
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::push_back
+// ------------------------------------------------------------------------------------------------
+// mtl::string::builder::release
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::builder with various types")
+{
+    mtl::string::builder sb;
+    CHECK_EQ(sb.empty(), true);
+    CHECK_EQ(sb.size(), 0);
+    CHECK_EQ(sb.view(), std::string_view());
+
+    const std::string text = "text";
+    sb.append("Hello").append(' ').append(std::string_view("World")).append(text);
+    sb.append(3, '!').append(true).append(false);
+    sb.append(std::numeric_limits<int64_t>::min()).append(static_cast<uint8_t>(255));
+    sb.append(2.5).append(-0.1f).append("abc", 2);
+    sb.push_back('|');
+    const std::string desired = "Hello Worldtext!!!truefalse-92233720368547758082552.5-0.1ab|";
+    CHECK_EQ(sb.view(), desired);
+    CHECK_EQ(sb.size(), desired.size());
+    CHECK_EQ(std::string(sb.data(), sb.size()), desired);
+    CHECK_EQ(sb.empty(), false);
+
+    sb.clear();
+    CHECK_EQ(sb.empty(), true);
+    sb.append("again");
+    CHECK_EQ(sb.release(), std::string("again"));
+    CHECK_EQ(sb.empty(), true);
+
+    const char* cs_nullptr = nullptr;
+    REQUIRE_THROWS_AS(sb.append(cs_nullptr), std::logic_error);
+
+    // check that is works correctly with UTF8 strings
+    sb.append(smiley).append(smiley);
+    CHECK_EQ(sb.release(), two_smileys);
+
+    mtl::string::builder sb_stream;
+    sb_stream.append("value ").append(42);
+    std::ostringstream stream;
+    stream << sb_stream;
+    CHECK_EQ(stream.str(), std::string("value 42"));
+    CHECK_EQ(mtl::string::to_string(sb_stream), std::string("value 42"));
+}
+
+TEST_CASE("mtl::string::builder growing past the inline storage")
+{
+    mtl::string::builder sb;
+    const size_t inline_capacity = sb.capacity();
+    std::string desired;
+    for (int i = 0; i < 10000; ++i)
+    {
+        sb.append(i).append(',');
+        desired += std::to_string(i);
+        desired += ',';
+    }
+    CHECK_GT(sb.capacity(), inline_capacity);
+    CHECK_EQ(sb.view(), desired);
+    CHECK_EQ(sb.release(), desired);
+    CHECK_EQ(sb.capacity(), inline_capacity);
+
+    sb.reserve(100000);
+    CHECK_GE(sb.capacity(), 100000);
+    sb.append(100000, 'a');
+    CHECK_EQ(sb.release(), std::string(100000, 'a'));
+}
+
+TEST_CASE("mtl::string::builder with mtl::string::arena")
+{
+    mtl::string::arena memory(1024);
+    std::vector<std::string> results;
+    std::vector<std::string> desired;
+    for (int i = 0; i < 20; ++i)
+    {
+        mtl::string::builder sb(memory);
+        std::string expected;
+        for (int j = 0; j < 100 * i; ++j)
+        {
+            sb.append(j).append(' ');
+            expected += std::to_string(j);
+            expected += ' ';
+        }
+        CHECK_EQ(sb.view(), expected);
+        results.emplace_back(sb.release());
+        desired.emplace_back(expected);
+    }
+    CHECK_EQ(results, desired);
+    CHECK_GT(memory.block_count(), 1);
+}
+
 // ------------------------------------------------------------------------------------------------
 // mtl::string::join_all
 // ------------------------------------------------------------------------------------------------
@@ -1957,6 +2768,36 @@ TEST_CASE("mtl::string::join_all")
     std::string vcc_desired = "127.0.0.1";
     CHECK_EQ(vcc_s, vcc_desired);
 
+    std::vector<long long> vll { std::numeric_limits<long long>::min(), 0, -1,
+                                 std::numeric_limits<long long>::max() };
+    std::string vll_s = mtl::string::join_all(vll.begin(), vll.end(), ' ');
+    std::string vll_desired = "-9223372036854775808 0 -1 9223372036854775807";
+    CHECK_EQ(vll_s, vll_desired);
+
+    std::vector<uint8_t> vu8 { 0, 7, 255 };
+    std::string vu8_s = mtl::string::join_all(vu8.begin(), vu8.end(), ",");
+    CHECK_EQ(vu8_s, std::string("0,7,255"));
+
+    std::vector<double> vd_extreme { -std::numeric_limits<double>::max(), 0.1, 1e-300, -0.0 };
+    std::string vd_extreme_s = mtl::string::join_all(vd_extreme.begin(), vd_extreme.end(), ' ');
+    std::string vd_extreme_desired = "-1.7976931348623157e+308 0.1 1e-300 -0";
+    CHECK_EQ(vd_extreme_s, vd_extreme_desired);
+
+    // the longest floating point numbers are formatted the same way as mtl::string::to_string
+    std::vector<float> vf_long { -1.17549435e-38f, -3.40282347e+38f, -1.23456791e+15f,
+                                 -std::numeric_limits<float>::denorm_min() };
+    std::vector<long double> vld_long { -std::numeric_limits<long double>::max(),
+                                        -std::numeric_limits<long double>::denorm_min(),
+                                        -1.234567890123456789e+17L };
+    for (const auto value : vf_long)
+    {
+        CHECK_EQ(mtl::string::join(value), mtl::string::to_string(value));
+    }
+    for (const auto value : vld_long)
+    {
+        CHECK_EQ(mtl::string::join(value), mtl::string::to_string(value));
+    }
+
     // check that is works correctly with UTF8 strings
     std::vector<std::string> smiles { smiley, smiley };
     std::string two_smiles = mtl::string::join_all(smiles.begin(), smiles.end());
@@ -2123,6 +2964,163 @@ TEST_CASE("mtl::string::join_all with non-empty output")
     CHECK_EQ((four_smiles_delim == (two_smileys_delimiter + two_smileys_delimiter)), true);
 }
 
+TEST_CASE("mtl::string::join_all with mtl::string::builder")
+{
+    std::vector<int> empty_vi;
+    mtl::string::builder empty_sb;
+    mtl::string::join_all(empty_vi.begin(), empty_vi.end(), empty_sb, ", ");
+    CHECK_EQ(empty_sb.empty(), true);
+
+    std::vector<int> vi {1, 2, 3, 4, 5};
+    mtl::string::builder vi_sb;
+    vi_sb.append("start ");
+    mtl::string::join_all(vi.begin(), vi.end(), vi_sb, ", ");
+    CHECK_EQ(vi_sb.view(), std::string_view("start 1, 2, 3, 4, 5"));
+
+    std::list<double> ld {10.555, 11.666, 12.777};
+    mtl::string::builder ld_sb;
+    mtl::string::join_all(ld.begin(), ld.end(), ld_sb, '_');
+    CHECK_EQ(ld_sb.view(), std::string_view("10.555_11.666_12.777"));
+
+    std::vector<std::string> names {"Bill", "Mary", "Nick"};
+    mtl::string::builder names_sb;
+    mtl::string::join_all(names.begin(), names.end(), names_sb, std::string(" | "));
+    CHECK_EQ(names_sb.release(), std::string("Bill | Mary | Nick"));
+
+    std::list<bool> vb {true, false};
+    mtl::string::builder vb_sb;
+    mtl::string::join_all(vb.begin(), vb.end(), vb_sb, "");
+    CHECK_EQ(vb_sb.release(), std::string("truefalse"));
+}
+
+TEST_CASE("mtl::string::join_all with ranges larger than the scratch arena blocks")
+{
+    std::vector<int> vi(300000);
+    std::string desired_vi;
+    for (size_t i = 0; i < vi.size(); ++i)
+    {
+        vi[i] = static_cast<int>(i % 100000) * 7919 - 1000000;
+        if (i > 0) { desired_vi += ", "; }
+        desired_vi += std::to_string(vi[i]);
+    }
+    std::string vi_s = mtl::string::join_all(vi.begin(), vi.end(), ", ");
+    CHECK_EQ(vi_s, desired_vi);
+
+    // check the result keeps what it already contains and the delimiter can be long
+    std::list<long> ll(vi.begin(), vi.end());
+    std::string delimiter(100, '-');
+    std::string desired_ll = "start";
+    for (auto it = ll.begin(); it != ll.end(); ++it)
+    {
+        if (it != ll.begin()) { desired_ll += delimiter; }
+        desired_ll += std::to_string(*it);
+    }
+    std::string ll_s = "start";
+    mtl::string::join_all(ll.begin(), ll.end(), ll_s, delimiter);
+    CHECK_EQ(ll_s, desired_ll);
+
+    std::vector<const char*> vcc(5000, "word");
+    std::string vcc_s = mtl::string::join_all(vcc.begin(), vcc.end());
+    std::string desired_vcc;
+    for (size_t i = 0; i < vcc.size(); ++i)
+    {
+        desired_vcc += "word";
+    }
+    CHECK_EQ(vcc_s, desired_vcc);
+
+    // elements much longer than the space kept free at the end of each block
+    std::vector<std::string> long_words;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        long_words.emplace_back((i * 37) % 3000, static_cast<char>('a' + (i % 26)));
+    }
+    std::vector<std::string_view> vsv(long_words.begin(), long_words.end());
+    std::string desired_vsv;
+    for (size_t i = 0; i < long_words.size(); ++i)
+    {
+        if (i > 0) { desired_vsv += "::"; }
+        desired_vsv += long_words[i];
+    }
+    CHECK_EQ(mtl::string::join_all(vsv.begin(), vsv.end(), "::"), desired_vsv);
+
+    std::vector<const char*> vlcc;
+    for (const auto& word : long_words) { vlcc.push_back(word.c_str()); }
+    CHECK_EQ(mtl::string::join_all(vlcc.begin(), vlcc.end(), "::"), desired_vsv);
+
+    // elements converted with mtl::string::to_string
+    std::vector<std::pair<std::string, int>> vp;
+    std::string desired_vp;
+    for (size_t i = 0; i < long_words.size(); ++i)
+    {
+        vp.emplace_back(long_words[i], static_cast<int>(i));
+        if (i > 0) { desired_vp += ' '; }
+        desired_vp += mtl::string::to_string(vp.back());
+    }
+    CHECK_EQ(mtl::string::join_all(vp.begin(), vp.end(), ' '), desired_vp);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::join_all_par
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::join_all_par with small ranges")
+{
+    std::vector<int> empty_vi;
+    std::string empty_i = mtl::string::join_all_par(empty_vi.begin(), empty_vi.end());
+    CHECK_EQ(empty_i, std::string());
+
+    std::vector<int> vi {1, 2, 3, 4, 5};
+    std::list<int> li {1, 2, 3, 4, 5};
+    std::string desired = "1, 2, 3, 4, 5";
+    CHECK_EQ(mtl::string::join_all_par(vi.begin(), vi.end(), ", "), desired);
+    CHECK_EQ(mtl::string::join_all_par(li.begin(), li.end(), std::string(", "), 4), desired);
+
+    std::vector<double> vd {10.555, 11.666, 12.777};
+    CHECK_EQ(mtl::string::join_all_par(vd.begin(), vd.end(), '_'), 
+             std::string("10.555_11.666_12.777"));
+
+    std::vector<std::string> names {"Bill", "Mary", "Nick"};
+    std::string names_s = "Names: ";
+    mtl::string::join_all_par(names.begin(), names.end(), names_s, " | ");
+    CHECK_EQ(names_s, std::string("Names: Bill | Mary | Nick"));
+}
+
+TEST_CASE("mtl::string::join_all_par with large ranges")
+{
+    std::vector<int> vi(200000);
+    for (size_t i = 0; i < vi.size(); ++i)
+    {
+        vi[i] = static_cast<int>(i % 100000) * 7919 - 1000000;
+    }
+    const std::string desired_vi = mtl::string::join_all(vi.begin(), vi.end(), ", ");
+    for (size_t threads = 0; threads < 6; ++threads)
+    {
+        std::string vi_s = mtl::string::join_all_par(vi.begin(), vi.end(), ", ", threads);
+        CHECK_EQ(vi_s, desired_vi);
+    }
+
+    std::list<double> ld;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        ld.push_back(static_cast<double>(i) * 0.37);
+    }
+    const std::string desired_ld = mtl::string::join_all(ld.begin(), ld.end(), ' ');
+    for (size_t threads = 0; threads < 6; ++threads)
+    {
+        std::string ld_s = mtl::string::join_all_par(ld.begin(), ld.end(), ' ', threads);
+        CHECK_EQ(ld_s, desired_ld);
+    }
+
+    std::vector<std::string> vs(100000, "text");
+    const std::string desired_vs = "start" + mtl::string::join_all(vs.begin(), vs.end());
+    std::string vs_s = "start";
+    mtl::string::join_all_par(vs.begin(), vs.end(), vs_s, "", 4);
+    CHECK_EQ(vs_s, desired_vs);
+
+    std::string vs_empty_delimiter = mtl::string::join_all_par(vs.begin(), vs.end());
+    CHECK_EQ(vs_empty_delimiter, mtl::string::join_all(vs.begin(), vs.end()));
+}
+
 // ------------------------------------------------------------------------------------------------
 // mtl::string::join
 // ------------------------------------------------------------------------------------------------
@@ -2157,6 +3155,17 @@ TEST_CASE("mtl::string::join")
     std::string multi_var = mtl::string::join(cs, mary, d, b, false, b, ", ", p);
     CHECK_EQ(multi_var, std::string("Hello Mary 2.2truefalsetrue, 33, d"));
 
+    std::string numbers = mtl::string::join(std::numeric_limits<int64_t>::min(), ' ',
+                                            std::numeric_limits<uint64_t>::max(), ' ',
+                                            static_cast<int8_t>(-128), ' ',
+                                            static_cast<unsigned short>(65535), ' ',
+                                            -std::numeric_limits<float>::max(), ' ', 
+                                            std::numeric_limits<double>::lowest(), ' ',
+                                            static_cast<long double>(0.5), ' ', 1e15, ' ', 1e16);
+    std::string numbers_desired = "-9223372036854775808 18446744073709551615 -128 65535 ";
+    numbers_desired += "-3.4028235e+38 -1.7976931348623157e+308 0.5 1000000000000000 1e+16";
+    CHECK_EQ(numbers, numbers_desired);
+
 
 
     // check that is works correctly with const char* that is nullptr
@@ -2206,6 +3215,15 @@ TEST_CASE("mtl::string::join")
     REQUIRE_EQ(empty_result10.empty(), true);
 
 
+    mtl::string::builder sb;
+    mtl::string::join(sb);
+    CHECK_EQ(sb.empty(), true);
+    mtl::string::join(sb, cs, mary, d, b, false, b, ", ", p);
+    CHECK_EQ(sb.view(), std::string_view("Hello Mary 2.2truefalsetrue, 33, d"));
+    mtl::string::join(sb, ' ', 154, 1.1f);
+    CHECK_EQ(sb.release(), std::string("Hello Mary 2.2truefalsetrue, 33, d 1541.1"));
+    REQUIRE_THROWS_AS(mtl::string::join(sb, 11, cs_nullptr), std::logic_error);
+
     // check that is works correctly with UTF8 strings
     std::string two_smiles = mtl::string::join(smiley, smiley);
     CHECK_EQ((two_smiles == smiley), false);
@@ -3324,6 +4342,259 @@ TEST_CASE("mtl::string::split with non-empty output and string delimiter and not
 
 
 
+TEST_CASE("mtl::string::split with char delimiter at every position of long text")
+{
+    // long enough text so delimiters end up in every position of the blocks processed with SIMD,
+    // as well as in the remaining characters at the end that are processed one at a time
+    std::string base;
+    for (int i = 0; i < 150; ++i)
+    {
+        base.push_back(static_cast<char>('a' + (i % 26)));
+    }
+
+    for (size_t position = 0; position < base.size(); position += 3)
+    {
+        std::string input = base;
+        input[position] = ',';
+        input[(position * 7) % input.size()] = ',';
+        input[input.size() - 1 - position] = ',';
+
+        // the char delimiter gives the same result as the equivalent string delimiter
+        const std::vector<std::string> desired = mtl::string::split(input, std::string(","));
+        const std::vector<std::string> result = mtl::string::split(input, ',');
+        CHECK_EQ((result == desired), true);
+
+        std::list<std::string> result_list { "abc" };
+        mtl::string::split(input, result_list, ',');
+        CHECK_EQ(result_list.size(), desired.size() + 1);
+        CHECK_EQ((std::equal(desired.begin(), desired.end(), std::next(result_list.begin()))),
+                 true);
+
+        std::vector<std::string> result_view;
+        for (const auto token : mtl::string::split_view(input, ','))
+        {
+            result_view.emplace_back(token);
+        }
+        CHECK_EQ((result_view == desired), true);
+    }
+}
+
+TEST_CASE("mtl::string::split with std::string_view that isn't null terminated")
+{
+    // the views end before the rest of the text so the last token has to stop at the view's end
+    const std::string text = "one, two, three|four, five";
+    const std::string_view view(text.data(), text.find('|'));
+    const std::vector<std::string> desired { "one", "two", "three" };
+
+    CHECK_EQ((mtl::string::split(view, ", ") == desired), true);
+    CHECK_EQ((mtl::string::split(view, std::string_view(", ")) == desired), true);
+
+    std::list<std::string> result_list;
+    mtl::string::split(view, result_list, std::string(", "));
+    CHECK_EQ((std::equal(desired.begin(), desired.end(), result_list.begin())), true);
+
+    const std::vector<std::string> desired_char { "one", " two", " three" };
+    CHECK_EQ((mtl::string::split(view, ',') == desired_char), true);
+
+    const std::vector<std::string> desired_any { "one", "two", "three" };
+    CHECK_EQ((mtl::string::split_any(view, ", ", true) == desired_any), true);
+}
+
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::split_view
+// ------------------------------------------------------------------------------------------------
+// mtl::string::split_view::begin
+// ------------------------------------------------------------------------------------------------
+// mtl::string::split_view::end
+// ------------------------------------------------------------------------------------------------
+// mtl::string::split_view::empty
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::split_view produces the same tokens as mtl::string::split")
+{
+    const std::vector<std::string> inputs
+    { "", " ", "a", "abc", "a b c", " a b c ", "a  b", "a,b,,c,", ",,", "a, b, c", ", , ",
+      "Greek : Χαίρετε, Japanese : こんにちは, Chinese : 你好", "no delimiters here at all" };
+    const std::vector<std::string> delimiters { " ", ",", ", ", "a", "abc", "xyz", "" };
+
+    for (const auto& input : inputs)
+    {
+        for (const auto& delimiter : delimiters)
+        {
+            const std::vector<std::string> desired = mtl::string::split(input, delimiter);
+            std::vector<std::string> result;
+            for (const auto token : mtl::string::split_view(input, delimiter))
+            {
+                result.emplace_back(token);
+            }
+            CHECK_EQ((result == desired), true);
+
+            // single character delimiters give the same result as the equivalent string
+            if (delimiter.size() == 1)
+            {
+                result.clear();
+                for (const auto token : mtl::string::split_view(input, delimiter[0]))
+                {
+                    result.emplace_back(token);
+                }
+                CHECK_EQ((result == desired), true);
+            }
+        }
+    }
+}
+
+TEST_CASE("mtl::string::split_view with empty input and default delimiter")
+{
+    const mtl::string::split_view empty_view("");
+    CHECK_EQ(empty_view.empty(), true);
+    CHECK_EQ((empty_view.begin() == empty_view.end()), true);
+
+    // the default delimiter is a space just like mtl::string::split
+    const std::string input = "The quick brown fox";
+    const mtl::string::split_view view(input);
+    CHECK_EQ(view.empty(), false);
+    CHECK_EQ(std::distance(view.begin(), view.end()), 4);
+    const std::vector<std::string_view> result(view.begin(), view.end());
+    const std::vector<std::string_view> desired { "The", "quick", "brown", "fox" };
+    CHECK_EQ((result == desired), true);
+}
+
+TEST_CASE("mtl::string::split_view iterators")
+{
+    const std::string input = "id,name,,score";
+    const mtl::string::split_view view(input, ',');
+
+    auto it = view.begin();
+    CHECK_EQ((*it == "id"), true);
+    CHECK_EQ(it->size(), 2);
+
+    // post-increment returns the previous token
+    auto previous = it++;
+    CHECK_EQ((*previous == "id"), true);
+    CHECK_EQ((*it == "name"), true);
+    CHECK_EQ((previous != it), true);
+
+    // iterators to the same token are equal
+    auto copy = it;
+    CHECK_EQ((copy == it), true);
+    ++it;
+    CHECK_EQ(it->empty(), true);
+    ++it;
+    CHECK_EQ((*it == "score"), true);
+    ++it;
+    CHECK_EQ((it == view.end()), true);
+    CHECK_EQ((copy == view.end()), false);
+
+    // the tokens point to the input so nothing is copied
+    CHECK_EQ((view.begin()->data() == input.data()), true);
+}
+
+TEST_CASE("mtl::string::split_view stopping early")
+{
+    std::string input;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        input += std::to_string(i) + "\t";
+    }
+
+    // find a field without splitting the rest of the input
+    size_t index = 0;
+    for (const auto token : mtl::string::split_view(input, '\t'))
+    {
+        if (token == "42") { break; }
+        ++index;
+    }
+    CHECK_EQ(index, 42);
+}
+
+
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::split_any
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::split_any with whitespace delimiters")
+{
+    const std::string input = " The quick\tbrown\r\nfox  jumps\n";
+
+    const std::vector<std::string> desired
+    { "", "The", "quick", "brown", "", "fox", "", "jumps", "" };
+    const std::vector<std::string> result = mtl::string::split_any(input, " \t\r\n");
+    CHECK_EQ((result == desired), true);
+
+    // empty tokens are not added
+    const std::vector<std::string> desired_skip { "The", "quick", "brown", "fox", "jumps" };
+    const std::vector<std::string> result_skip = mtl::string::split_any(input, " \t\r\n", true);
+    CHECK_EQ((result_skip == desired_skip), true);
+
+    // output to a container that is not empty
+    std::list<std::string> result_list { "abc" };
+    mtl::string::split_any(input, result_list, " \t\r\n", true);
+    const std::list<std::string> desired_list { "abc", "The", "quick", "brown", "fox", "jumps" };
+    CHECK_EQ((result_list == desired_list), true);
+}
+
+TEST_CASE("mtl::string::split_any produces the same tokens as mtl::string::split")
+{
+    const std::vector<std::string> inputs
+    { " ", "a", "abc", "a b c", " a b c ", "a  b", "a,b,,c,", ",,", "a, b, c", ", , ",
+      "Greek : Χαίρετε, Japanese : こんにちは, Chinese : 你好", "no delimiters here at all" };
+
+    // with a single delimiter the result is the same as mtl::string::split
+    for (const auto& input : inputs)
+    {
+        for (const char delimiter : std::string(" ,a"))
+        {
+            const std::vector<std::string> desired = mtl::string::split(input, delimiter);
+            const std::vector<std::string> result =
+            mtl::string::split_any(input, std::string(1, delimiter));
+            CHECK_EQ((result == desired), true);
+        }
+    }
+}
+
+TEST_CASE("mtl::string::split_any with empty input and empty delimiters")
+{
+    // an empty input has no tokens
+    CHECK_EQ(mtl::string::split_any(std::string(), ", ").empty(), true);
+    CHECK_EQ(mtl::string::split_any(std::string(), ", ", true).empty(), true);
+
+    // no delimiters gives the entire input
+    const std::vector<std::string> desired { "a, b" };
+    CHECK_EQ((mtl::string::split_any("a, b", "") == desired), true);
+
+    // only delimiters gives only empty tokens
+    const std::vector<std::string> desired_empty { "", "", "", "" };
+    CHECK_EQ((mtl::string::split_any(",;,", ";,") == desired_empty), true);
+    CHECK_EQ(mtl::string::split_any(",;,", ";,", true).empty(), true);
+}
+
+TEST_CASE("mtl::string::split_any with characters outside of ASCII")
+{
+    // characters with values above 127 can be delimiters too
+    std::string input = "a";
+    input.push_back(static_cast<char>(200));
+    input += "b";
+    input.push_back(static_cast<char>(255));
+    input += "c";
+    std::string delimiters;
+    delimiters.push_back(static_cast<char>(255));
+    delimiters.push_back(static_cast<char>(200));
+
+    const std::vector<std::string> desired { "a", "b", "c" };
+    CHECK_EQ((mtl::string::split_any(input, delimiters) == desired), true);
+}
+
+
+
+
+
 // ------------------------------------------------------------------------------------------------
 // mtl::string::replace
 // ------------------------------------------------------------------------------------------------
@@ -3982,6 +5253,181 @@ TEST_CASE("mtl::string::replace for long std::string")
     CHECK_EQ(utf8_s32 , utf8_s32_result);
 }
 
+TEST_CASE("mtl::string::replace for long std::string with many matches")
+{
+    // replacements that are larger, the same size and smaller than the match, with a number of
+    // matches around the number of positions that are kept without allocating
+    const std::string match = "<match>";
+    const std::vector<std::string> replacements { "<larger replacement>", "<MATCH>", "<m>", "" };
+    const std::vector<size_t> match_counts { 1, 31, 32, 33, 64, 65, 500 };
+    const std::string filler = "text between matches, ";
+
+    for (const auto& replacement : replacements)
+    {
+        for (const auto match_count : match_counts)
+        {
+            std::string input = filler + filler + filler + filler + filler + filler;
+            std::string result = input;
+            for (size_t i = 0; i < match_count; ++i)
+            {
+                input += match + filler;
+                result += replacement + filler;
+            }
+            // matches at the start and at the end of the input
+            input = match + input + match;
+            result = replacement + result + replacement;
+
+            REQUIRE_EQ((input.size() >= 128), true);
+            mtl::string::replace(input, match, replacement);
+            CHECK_EQ(input, result);
+        }
+    }
+
+    // matches next to each other
+    std::string adjacent(600, 'a');
+    mtl::string::replace(adjacent, "aa", "bbb");
+    CHECK_EQ(adjacent, std::string(900, 'b'));
+
+    std::string adjacent_shrink(600, 'a');
+    mtl::string::replace(adjacent_shrink, "aaa", "b");
+    CHECK_EQ(adjacent_shrink, std::string(200, 'b'));
+}
+
+TEST_CASE("mtl::string::replace with std::string_view")
+{
+    // matches and replacements can be views to parts of other strings
+    const std::string words = "cat dog";
+    const std::string_view cat(words.data(), 3);
+    const std::string_view dog(words.data() + 4, 3);
+
+    std::string text = "A cat and another cat.";
+    CHECK_EQ(mtl::string::replace(text, cat, dog), 2);
+    CHECK_EQ(text, std::string("A dog and another dog."));
+    CHECK_EQ(mtl::string::replace(text, dog, 'X'), 2);
+    CHECK_EQ(text, std::string("A X and another X."));
+    CHECK_EQ(mtl::string::replace(text, 'X', cat), 2);
+    CHECK_EQ(text, std::string("A cat and another cat."));
+
+    // with long std::string
+    std::string long_text(200, 'z');
+    long_text = long_text + "cat" + long_text;
+    CHECK_EQ(mtl::string::replace(long_text, cat, std::string_view("tiger")), 1);
+    CHECK_EQ(long_text, std::string(200, 'z') + "tiger" + std::string(200, 'z'));
+}
+
+TEST_CASE("mtl::string::replace returns the number of replacements")
+{
+    std::string short_text = "one two one two one";
+    CHECK_EQ(mtl::string::replace(short_text, "one", "three"), 3);
+    CHECK_EQ(short_text, std::string("three two three two three"));
+    CHECK_EQ(mtl::string::replace(short_text, "four", "five"), 0);
+    CHECK_EQ(mtl::string::replace(short_text, 't', 'T'), 5);
+    CHECK_EQ(short_text, std::string("Three Two Three Two Three"));
+    CHECK_EQ(mtl::string::replace(short_text, ' ', ""), 4);
+    CHECK_EQ(short_text, std::string("ThreeTwoThreeTwoThree"));
+
+    // for long std::string with larger and smaller replacements
+    std::string long_text(400, 'z');
+    long_text = "#" + long_text + "#" + long_text + "#";
+    CHECK_EQ(mtl::string::replace(long_text, "#", "Mike"), 3);
+    CHECK_EQ(mtl::string::replace(long_text, "Mike", ""), 3);
+    CHECK_EQ(long_text.size(), 800);
+    CHECK_EQ(mtl::string::replace(long_text, "#", "Mike"), 0);
+
+    // an empty match doesn't replace anything for both short and long std::string
+    std::string empty_match_short = "abc";
+    CHECK_EQ(mtl::string::replace(empty_match_short, "", "x"), 0);
+    CHECK_EQ(empty_match_short, std::string("abc"));
+    CHECK_EQ(mtl::string::replace(empty_match_short, "", 'x'), 0);
+    CHECK_EQ(empty_match_short, std::string("abc"));
+    std::string empty_match_long = long_text;
+    CHECK_EQ(mtl::string::replace(empty_match_long, "", "x"), 0);
+    CHECK_EQ(empty_match_long, long_text);
+}
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::replace_copy
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::replace_copy with an output iterator")
+{
+    const std::string_view text = "Hello {name}, welcome {name}.";
+
+    // with std::back_inserter
+    std::vector<char> chars;
+    CHECK_EQ(mtl::string::replace_copy(text, "{name}", "Jill", std::back_inserter(chars)), 2);
+    CHECK_EQ(std::string(chars.begin(), chars.end()), std::string("Hello Jill, welcome Jill."));
+
+    // with a pointer to a buffer, the number of replacements gives the size of the output
+    std::array<char, 64> buffer {};
+    const std::string_view match = "{name}";
+    const std::string_view replacement = "Jack Smith";
+    const size_t count = mtl::string::replace_copy(text, match, replacement, buffer.data());
+    CHECK_EQ(count, 2);
+    const size_t output_size = text.size() + (count * (replacement.size() - match.size()));
+    CHECK_EQ(std::string(buffer.data(), output_size),
+             std::string("Hello Jack Smith, welcome Jack Smith."));
+
+    // with nothing matching the input is copied
+    std::vector<char> unchanged;
+    CHECK_EQ(mtl::string::replace_copy(text, "{age}", "20", std::back_inserter(unchanged)), 0);
+    CHECK_EQ(std::string(unchanged.begin(), unchanged.end()), std::string(text));
+
+    // with an empty match the input is copied
+    std::vector<char> empty_match;
+    CHECK_EQ(mtl::string::replace_copy(text, "", "20", std::back_inserter(empty_match)), 0);
+    CHECK_EQ(std::string(empty_match.begin(), empty_match.end()), std::string(text));
+
+    // with empty input
+    std::vector<char> empty_input;
+    CHECK_EQ(mtl::string::replace_copy("", "{name}", "Jill", std::back_inserter(empty_input)), 0);
+    CHECK_EQ(empty_input.empty(), true);
+}
+
+TEST_CASE("mtl::string::replace_copy with std::string")
+{
+    const std::string_view text = "Hello {name}, welcome {name}.";
+
+    // the output is appended to the std::string
+    std::string result = "> ";
+    CHECK_EQ(mtl::string::replace_copy(text, "{name}", "Jill", result), 2);
+    CHECK_EQ(result, std::string("> Hello Jill, welcome Jill."));
+
+    // with a smaller replacement
+    std::string smaller;
+    CHECK_EQ(mtl::string::replace_copy(text, "{name}", "", smaller), 2);
+    CHECK_EQ(smaller, std::string("Hello , welcome ."));
+
+    // with nothing matching the input is copied
+    std::string unchanged;
+    CHECK_EQ(mtl::string::replace_copy(text, "{age}", "20", unchanged), 0);
+    CHECK_EQ(unchanged, std::string(text));
+
+    // with an empty match the input is copied
+    std::string empty_match;
+    CHECK_EQ(mtl::string::replace_copy(text, "", "20", empty_match), 0);
+    CHECK_EQ(empty_match, std::string(text));
+
+    // with matches at the start, at the end and next to each other
+    std::string edges;
+    CHECK_EQ(mtl::string::replace_copy("aabaa", "a", "cd", edges), 4);
+    CHECK_EQ(edges, std::string("cdcdbcdcd"));
+
+    // gives the same result as mtl::string::replace for long input with many matches
+    std::string long_text;
+    for (size_t i = 0; i < 200; ++i) { long_text += "some text with a match "; }
+    std::string replaced = long_text;
+    const size_t replace_count = mtl::string::replace(replaced, "match", "replacement");
+    std::string copied;
+    CHECK_EQ(mtl::string::replace_copy(long_text, "match", "replacement", copied), replace_count);
+    CHECK_EQ(copied, replaced);
+
+    // with characters outside of ASCII
+    std::string utf8_result;
+    CHECK_EQ(mtl::string::replace_copy("Ελληνικά κείμενο", "κείμενο", "文字", utf8_result), 1);
+    CHECK_EQ(utf8_result, std::string("Ελληνικά 文字"));
+}
+
 // ------------------------------------------------------------------------------------------------
 // mtl::string::replace_all
 // ------------------------------------------------------------------------------------------------
@@ -4088,3 +5534,181 @@ TEST_CASE("mtl::string::replace_all")
     mtl::string::replace_all(text_to_fmt, num_holes, names);
     CHECK_EQ(text_to_fmt, result_fmt);
 }
+
+
+
+// ------------------------------------------------------------------------------------------------
+// mtl::string::replacer
+// ------------------------------------------------------------------------------------------------
+// mtl::string::replacer::size
+// ------------------------------------------------------------------------------------------------
+// mtl::string::replacer::replace
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("mtl::string::replacer")
+{
+    // default constructed replacer doesn't replace anything
+    const mtl::string::replacer empty_replacer;
+    std::string text = "Hello world";
+    empty_replacer.replace(text);
+    CHECK_EQ(empty_replacer.size(), 0);
+    CHECK_EQ(text, std::string("Hello world"));
+
+    // like a simpler version of C++ 20 std::format replacing all {0}{1}{2} holes with replacement
+    // elements
+    std::vector<std::string> num_holes = { "{0}", "{1}", "{2}" };
+    std::vector<std::string> names = { "Jill", "Jack", "Joe" };
+    const mtl::string::replacer fmt_replacer(num_holes, names);
+    CHECK_EQ(fmt_replacer.size(), 3);
+
+    std::string text_to_fmt = "Hello {0}, {1} and {2}";
+    fmt_replacer.replace(text_to_fmt);
+    CHECK_EQ(text_to_fmt, std::string("Hello Jill, Jack and Joe"));
+
+    // the same replacer can be reused
+    std::string text_to_fmt2 = "{2}{2}{1}{0}";
+    fmt_replacer.replace(text_to_fmt2);
+    CHECK_EQ(text_to_fmt2, std::string("JoeJoeJackJill"));
+
+    // with the mtl::string::replace_all overload
+    std::string text_to_fmt3 = "{1} and {0}";
+    mtl::string::replace_all(text_to_fmt3, fmt_replacer);
+    CHECK_EQ(text_to_fmt3, std::string("Jack and Jill"));
+
+    // with empty input std::string
+    std::string empty;
+    fmt_replacer.replace(empty);
+    CHECK_EQ(empty.empty(), true);
+
+    // with nothing matching to replace
+    fmt_replacer.replace(text);
+    CHECK_EQ(text, std::string("Hello world"));
+}
+
+TEST_CASE("mtl::string::replacer with overlapping matches")
+{
+    // the classic Aho-Corasick example where matches end inside other matches
+    std::vector<std::string> matches = { "he", "she", "his", "hers" };
+    std::vector<std::string> replacements = { "1", "2", "3", "4" };
+    const mtl::string::replacer overlap_replacer(matches, replacements);
+
+    // the match that starts first is replaced
+    std::string ushers = "ushers";
+    overlap_replacer.replace(ushers);
+    CHECK_EQ(ushers, std::string("u2rs"));
+
+    // for matches that start at the same position the longest is replaced
+    std::string hers = "hers hex his";
+    overlap_replacer.replace(hers);
+    CHECK_EQ(hers, std::string("4 1x 3"));
+
+    // replacements are never searched for other matches
+    std::vector<std::string> chain_matches = { "a", "b" };
+    std::vector<std::string> chain_replacements = { "b", "c" };
+    const mtl::string::replacer chain_replacer(chain_matches, chain_replacements);
+    std::string chain = "aabb";
+    chain_replacer.replace(chain);
+    CHECK_EQ(chain, std::string("bbcc"));
+
+    // for the same match given more than once the first one is used
+    std::vector<std::string> duplicate_matches = { "cat", "dog", "cat" };
+    std::vector<std::string> duplicate_replacements = { "lion", "wolf", "tiger" };
+    const mtl::string::replacer duplicate_replacer(duplicate_matches, duplicate_replacements);
+    CHECK_EQ(duplicate_replacer.size(), 2);
+    std::string pets = "cat and dog";
+    duplicate_replacer.replace(pets);
+    CHECK_EQ(pets, std::string("lion and wolf"));
+
+    // with replacements that are empty
+    std::vector<std::string> remove_matches = { "aa", "b" };
+    std::vector<std::string> remove_replacements = { "", "" };
+    const mtl::string::replacer remove_replacer(remove_matches, remove_replacements);
+    std::string removed = "aaabaab";
+    remove_replacer.replace(removed);
+    CHECK_EQ(removed, std::string("a"));
+}
+
+TEST_CASE("mtl::string::replacer with long std::string")
+{
+    std::vector<std::string> num_matches { "1", "2", "3" };
+    std::vector<std::string> num_replacements { "one", "two", "three" };
+    const mtl::string::replacer num_replacer(num_matches, num_replacements);
+
+    const std::string long_string(400, 'z');
+    std::string mmb_long = "[123][123][123][123]";
+    mmb_long = mmb_long + mmb_long + mmb_long + mmb_long + mmb_long;
+    mmb_long = mmb_long + long_string + mmb_long;
+    std::string mmb_long_copy = mmb_long;
+
+    std::string mrb_long = "[onetwothree][onetwothree][onetwothree][onetwothree]";
+    mrb_long = mrb_long + mrb_long + mrb_long + mrb_long + mrb_long;
+    mrb_long = mrb_long + long_string + mrb_long;
+
+    num_replacer.replace(mmb_long);
+    CHECK_EQ(mmb_long, mrb_long);
+
+    // when matches don't interact it gives the same result as mtl::string::replace_all
+    mtl::string::replace_all(mmb_long_copy, num_matches, num_replacements);
+    CHECK_EQ(mmb_long, mmb_long_copy);
+}
+
+TEST_CASE("mtl::string::replacer with many nested matches")
+{
+    // every match is a prefix of the next so each position has many overlapping matches
+    std::vector<std::string> nested_matches;
+    std::vector<std::string> nested_replacements;
+    for (size_t i = 1; i <= 32; ++i)
+    {
+        nested_matches.emplace_back(i, 'a');
+        nested_replacements.emplace_back(std::to_string(i));
+    }
+    const mtl::string::replacer nested_replacer(nested_matches, nested_replacements);
+
+    // the longest match is replaced each time and the remainder by the longest that fits
+    std::string nested(100, 'a');
+    nested_replacer.replace(nested);
+    CHECK_EQ(nested, std::string("3232324"));
+
+    std::string nested_mixed = "baaab" + std::string(33, 'a') + "b";
+    nested_replacer.replace(nested_mixed);
+    CHECK_EQ(nested_mixed, std::string("b3b321b"));
+
+    // many long matches that share a prefix
+    std::vector<std::string> long_matches;
+    std::vector<std::string> long_replacements;
+    const std::string prefix(100, 'p');
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        long_matches.emplace_back("{" + prefix + std::to_string(i) + "}");
+        long_replacements.emplace_back(std::to_string(i));
+    }
+    const mtl::string::replacer long_replacer(long_matches, long_replacements);
+    CHECK_EQ(long_replacer.size(), 1000);
+
+    std::string long_text = "<" + long_matches[7] + long_matches[999] + "{" + prefix + "}>";
+    long_replacer.replace(long_text);
+    CHECK_EQ(long_text, "<7999{" + prefix + "}>");
+}
+
+TEST_CASE("mtl::string::replacer with characters outside of ASCII")
+{
+    const std::vector<std::string> matches { "Ελληνικά", "κείμενο", "文字" };
+    const std::vector<std::string> replacements { "Greek", "text", "characters" };
+    const mtl::string::replacer utf8_replacer(matches, replacements);
+
+    std::string utf8_text = "Ελληνικά κείμενο και 文字";
+    utf8_replacer.replace(utf8_text);
+    CHECK_EQ(utf8_text, std::string("Greek text και characters"));
+}
+
+TEST_CASE("mtl::string::replacer throws")
+{
+    // with containers of different size it should throw std::invalid_argument
+    std::vector<std::string> matches { "Joe", "Jill", "Jack" };
+    std::vector<std::string> replacements { "One", "Two" };
+    REQUIRE_THROWS_AS((mtl::string::replacer(matches, replacements)), std::invalid_argument);
+
+    // with an empty match it should throw std::invalid_argument
+    std::vector<std::string> empty_match { "Joe", "" };
+    REQUIRE_THROWS_AS((mtl::string::replacer(empty_match, replacements)), std::invalid_argument);
+}
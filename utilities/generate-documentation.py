@@ -151,18 +151,19 @@ def remove_namespaces(item_name):
     return formatted_name
 
 
-def find_line_header(filename, item_name):
+def find_line_header(filename, item_name, start_line=1):
     '''
     Given a filename and a class or function name finds the line where the it
-    is located in the header.
+    is located in the header. The search starts from the given line, so class
+    member functions can be searched for starting from their class.
     '''
     lines = []
     with open(filename, 'r', encoding='utf-8') as input_file:
         lines = input_file.readlines()
 
-    count = 1
+    count = start_line
     formatted_name = remove_namespaces(item_name)
-    for line in lines:
+    for line in lines[start_line - 1:]:
         # by adding spaces in the front and back we make sure the name isn't
         # just a part of another name
         if (' ' + formatted_name + ' ') in line:
@@ -270,6 +271,9 @@ def generate_documentation(sources):
         # keep track of he last class found to match functions that belong to
         # that class
         last_class = ''
+        # the line of the last class found in the header, the class member
+        # functions are searched for starting from it
+        last_class_line = 1
         for name in names:
             # check if the current element is a class
             is_class = False
@@ -301,7 +305,13 @@ def generate_documentation(sources):
                         class_function_count = class_function_count + 1
 
             # add the line number for item in the header as Markdown requires
-            header_line_number = find_line_header(header_filename, name)
+            if is_class_function == True:
+                header_line_number = find_line_header(header_filename, name,
+                                                      last_class_line)
+            else:
+                header_line_number = find_line_header(header_filename, name)
+            if is_class == True:
+                last_class_line = header_line_number
             header_location = header_filename + '#L' + str(header_line_number)
 
             # add the line number for item in the source as Markdown requires